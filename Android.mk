@@ -16,7 +16,7 @@ LOCAL_MODULE := libylisp
 LOCAL_SRC_FILES := \
 	ylisp/gsym.c   ylisp/interpret.c  ylisp/lisp.c     ylisp/mempool.c   ylisp/mthread.c \
 	ylisp/nfunc.c  ylisp/nfunc_mt.c   ylisp/parser.c   ylisp/sfunc.c     ylisp/symlookup.c \
-	ylisp/trie.c   ylisp/ut.c
+	ylisp/trie.c   ylisp/ut.c         ylisp/intern.c
 LOCAL_CFLAGS := -DHAVE_CONFIG_H
 LOCAL_C_INCLUDES += $(NDK_PROJECT_PATH)
 include $(BUILD_STATIC_LIBRARY)
@@ -418,8 +418,11 @@ _start_test_script(const char* fname, FILE* fh, int bmt) {
 			if (bmtok)
 				pthread_create(&thd, NULL,
 					       &_interp_thread, targ);
-			else
+			else {
+				/* section not for MT is skipped */
 				_free_thdarg(targ);
+				_dec_tcnt();
+			}
 		}
 		yldynbstr_reset(&dyb);
 	}
@@ -527,6 +530,9 @@ main(int argc, char* argv[]) {
 	sys.mode    = YLMode_batch;
 	sys.mpsz    = 8*1024;
 	sys.gctp    = 1;
+	sys.gcpause = 50; /* test incremental GC */
+	sys.gcthread = 4; /* test parallel GC */
+	sys.gcregion = 1; /* test region mode */
 
 	ylinit(&sys);
 
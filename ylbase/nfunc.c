@@ -37,20 +37,18 @@ ylbase_nfunc_init(void) {
 	 * Making lambda element
 	 * This element is not from memory full.
 	 * So, never GCed and cleaned.
-	 * That's why hard-coded string "lambda" is allowd
 	 */
-	ylaassign_sym(&_elambda, "lambda");
-	ylaassign_sym(&_eprogn,   "progn");
+	ylaassign_csym(&_elambda, "lambda");
+	ylaassign_csym(&_eprogn,   "progn");
 	return 0;
 }
 
 
 YLDEFNF(progn, 1, 9999) {
-	yle_t*  ret = ylnil();
-	ylelist_foreach(e) {
-		ret = yleval(cxt, ylcar(e), a);
-	}
-	return ret;
+	/* last expression is in tail position */
+	for (; !yleis_nil(ylpcdr(e)); e = ylpcdr(e))
+		yleval(cxt, ylcar(e), a);
+	return yleval_tail(cxt, ylcar(e), a);
 } YLENDNF(progn)
 
 /*
@@ -78,7 +76,7 @@ _evcon(yletcxt_t* cxt, yle_t* c, yle_t* a) {
 	 * But, we need to preserve 'c' explicitly.
 	 */
 	return yleis_true(yleval(cxt, ylcaar(c), a))?
-		yleval(cxt, ylcadar(c), a):
+		yleval_tail(cxt, ylcadar(c), a):
 		_evcon(cxt, ylcdr(c), a);
 }
 
@@ -145,7 +143,7 @@ YLDEFNF(f_let, 2, 9999) {
 	body = ylcons(&_eprogn, ylcdr(e));
 
 	if (yleis_nil(argl))
-		ret = yleval(cxt, body, a);
+		ret = yleval_tail(cxt, body, a);
 	else {
 		if (yleis_nil(param))
 			ylnfinterp_fail(YLErr_func_invalid_param,
@@ -159,7 +157,7 @@ YLDEFNF(f_let, 2, 9999) {
 
 			     param);
 		/* keep exp from GC. */
-		ret = yleval(cxt, exp, a);
+		ret = yleval_tail(cxt, exp, a);
 	}
 	return ret;
 } YLENDNF(f_let)
@@ -175,7 +173,7 @@ YLDEFNF(f_case, 2, 9999) {
 	e = ylcdr(e);
 	ylelist_foreach(e) {
 		if (ylais_type(ylcaar(e), ylaif_sym())
-		    && (0 == strcmp(ylasym(ylcaar(e)).sym,
+		    && (0 == strcmp(ylasymstr(ylcaar(e)),
 				    __DEFAULT_KEYWORD)))
 			/* unconditionally TRUE */
 			break;
@@ -260,12 +258,14 @@ YLDEFNF(cdr, 1, 1) {
 YLDEFNF(setcar, 2, 2) {
 	ylnfcheck_parameter(!yleis_atom(ylcar(e)));
 	ylpsetcar(ylcar(e), ylcadr(e));
+	ylmcache_invalidate();
 	return ylt();
 } YLENDNF(setcar)
 
 YLDEFNF(setcdr, 2, 2) {
 	ylnfcheck_parameter(!yleis_atom(ylcar(e)));
 	ylpsetcdr(ylcar(e), ylcadr(e));
+	ylmcache_invalidate();
 	return ylt();
 } YLENDNF(setcdr)
 
@@ -336,7 +336,7 @@ YLDEFNF(printf, 1, 10) {
 	if (!s)
 		goto bail;
 	memset(s, 0, sizeof(char*) * (pcsz-1));
-	fmt = ylasym(ylcar(e)).sym;
+	fmt = ylasymstr(ylcar(e));
 	for (i=0, e=ylcdr(e); !yleis_nil(e); i++, e=ylcdr(e)) {
 		ylechain_print(ylethread_buf(cxt), ylcar(e));
 		s[i] = ylmalloc(yldynb_sz(ylethread_buf(cxt)));
@@ -415,7 +415,7 @@ YLDEFNF(prlog, 2, 9999) {
 	const char*  lvstr;
 	int          loglv;
 	ylnfcheck_parameter(ylais_type(ylcar(e), ylaif_sym()));
-	lvstr = ylasym(ylcar(e)).sym;
+	lvstr = ylasymstr(ylcar(e));
 	if (0 == lvstr[0] || 0 != lvstr[1])
 		goto invalid_loglv;
 
@@ -466,7 +466,7 @@ YLDEFNF(concat, 2, 9999) {
 	/* calculate total string length */
 	len = 0; pe = e;
 	while (!yleis_nil(pe)) {
-		len += strlen(ylasym(ylcar(pe)).sym);
+		len += strlen(ylasymstr(ylcar(pe)));
 		pe = ylcdr(pe);
 	}
 
@@ -479,8 +479,8 @@ YLDEFNF(concat, 2, 9999) {
 
 	pe = e; p = buf;
 	while (!yleis_nil(pe)) {
-		strcpy(p, ylasym(ylcar(pe)).sym);
-		p += strlen(ylasym(ylcar(pe)).sym);
+		strcpy(p, ylasymstr(ylcar(pe)));
+		p += strlen(ylasymstr(ylcar(pe)));
 		pe = ylcdr(pe);
 	}
 	*p = 0; /* trailing 0 */
@@ -640,7 +640,7 @@ YLDEFNF(gt, 2, 2) {
 	if (ylaif_dbl() == ylaif(ylcar(e)))
 		return (yladbl(p1) > yladbl(p2))? ylt(): ylnil();
 	else
-		return (strcmp(ylasym(p1).sym, ylasym(p2).sym) > 0)?
+		return (strcmp(ylasymstr(p1), ylasymstr(p2)) > 0)?
 			ylt():
 			ylnil();
 } YLENDNF(gt)
@@ -653,7 +653,7 @@ YLDEFNF(lt, 2, 2) {
 	if (ylaif_dbl() == ylaif(ylcar(e)))
 		return (yladbl(p1) < yladbl(p2))? ylt(): ylnil();
 	else
-		return (strcmp(ylasym(p1).sym, ylasym(p2).sym) < 0)?
+		return (strcmp(ylasymstr(p1), ylasymstr(p2)) < 0)?
 			ylt():
 			ylnil();
 } YLENDNF(lt)
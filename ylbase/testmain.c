@@ -89,6 +89,9 @@ main(int argc, char* argv[]) {
 	sys.mode    = YLMode_batch;
 	sys.mpsz    = 4*1024;
 	sys.gctp    = 80;
+	sys.gcpause = 0;
+	sys.gcthread = 1;
+	sys.gcregion = 0;
 
 	ylinit(&sys);
 
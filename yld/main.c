@@ -213,6 +213,9 @@ main(int argc, const char* argv[]) {
 		sys.mode    = YLMode_batch;
 		sys.mpsz    = 4*1024;
 		sys.gctp    = 80;
+		sys.gcpause = 1000; /* 1 msec - keep sessions responsive */
+		sys.gcthread = 0;
+		sys.gcregion = 0;
 
 		if (YLOk != ylinit(&sys)) {
 			printf("Fail to initialize ylisp\n");
@@ -99,12 +99,13 @@ _load_lib(yletcxt_t* cxt, const char* path_sym) {
 	strcpy(sym, path_sym);
 	libpath = ylacreate_sym(sym);
 
-	if (ylis_set(cxt, ylnil(), sym)) {
+	/* 'sym' is freed. (See 'ylaassign_sym') */
+	if (ylis_set(cxt, ylnil(), ylasymstr(libpath))) {
 		libpath = yleval(cxt, libpath, ylnil());
 		if (!yleis_nil(libpath)
 		    && ylais_type(libpath, ylaif_sym()) ) {
 			/* if there is library, let's use it! */
-			return dlopen(ylasym(libpath).sym,
+			return dlopen(ylasymstr(libpath),
 				      RTLD_NOW | RTLD_GLOBAL);
 		}
 	}
@@ -58,8 +58,10 @@ static inline void
 _destroy_arr_data(_earr_t* at) {
 	ylassert(at);
 	/* unlinking is enough! */
-	if (at->arr)
+	if (at->arr) {
+		ylmp_ext_free(sizeof(*at->arr) * at->sz);
 		ylfree(at->arr);
+	}
 	/* see comments at '_atrie_destroy' in 'nfunc_trie.c' */
 	pthread_rwlock_destroy(&at->m);
 	ylfree(at);
@@ -164,12 +166,21 @@ _aif_arr_clean(yle_t* e) {
 	ylacd(e) = NULL; /* <- I'm not sure that this is essential or not! */
 }
 
+static unsigned long
+_aif_arr_size(const yle_t* e) {
+	_earr_t* at = ylacd(e);
+	return at? sizeof(*at) + sizeof(*at->arr) * at->sz: 0;
+}
+
 static ylatomif_t _aif_arr = {
 	&_aif_arr_eq,
 	NULL,
 	&_aif_arr_to_string,
 	&_aif_arr_visit,
-	&_aif_arr_clean
+	&_aif_arr_clean,
+	1, /* clean at finalizer */
+	"arr",
+	&_aif_arr_size
 };
 
 static inline int
@@ -200,6 +211,7 @@ _arr_alloc(yle_t* ar, yle_t* e) {
 		if (!at->arr)
 			goto oom;
 		memset(at->arr, 0, sizeof(*at->arr) * at->sz);
+		ylmp_ext_alloc(sizeof(*at->arr) * at->sz);
 	} else
 		at->arr = NULL;
 
@@ -253,10 +265,13 @@ YLDEFNF(make_array, 1, 9999) {
 
   /*
    * Get array value pointer of given index!
+   * @owner : [out] array atom that has returned value pointer.
+   *          (can be NULL if not interested in.)
    * return NULL if fails
    */
 static yle_t**
-_arr_get(yle_t* e, yle_t* ie, int (*lock)(pthread_rwlock_t*)) {
+_arr_get(yle_t* e, yle_t* ie, int (*lock)(pthread_rwlock_t*),
+	 yle_t** owner) {
 	const _earr_t*  at;
 	yle_t**         ret = NULL;
 	long long       i = yladbl(ylcar(ie));
@@ -267,14 +282,16 @@ _arr_get(yle_t* e, yle_t* ie, int (*lock)(pthread_rwlock_t*)) {
 		return NULL;
 	}
 
-	if (yleis_nil(ylcdr(ie)))
+	if (yleis_nil(ylcdr(ie))) {
 		/* this is last dim-index */
 		ret =  &at->arr[i];
-	else {
+		if (owner)
+			*owner = e;
+	} else {
 		yle_t*  ne = at->arr[i]; /* next e */
 		if (_is_arr_type(ne) && ylacd(ne)) {
 			lock( &((_earr_t*)ylacd(ne))->m );
-			ret = _arr_get(at->arr[i], ylcdr(ie), lock);
+			ret = _arr_get(at->arr[i], ylcdr(ie), lock, owner);
 			pthread_rwlock_unlock(&((_earr_t*)ylacd(ne))->m);
 		} else
 			yllogE("Invalid Array Access\n");
@@ -295,7 +312,7 @@ YLDEFNF(arr_get, 2, 9999) {
 	at = ylacd( ylcar(e));
 
 	pthread_rwlock_rdlock( &at->m );
-	pv = _arr_get(ylcar(e), ylcdr(e), &pthread_rwlock_rdlock);
+	pv = _arr_get(ylcar(e), ylcdr(e), &pthread_rwlock_rdlock, NULL);
 	pthread_rwlock_unlock( &at->m );
 
 	if (pv)
@@ -307,6 +324,7 @@ YLDEFNF(arr_get, 2, 9999) {
 
 YLDEFNF(arr_set, 3, 9999) {
 	yle_t**     pv;
+	yle_t*      owner;
 	_earr_t*    at;
 
 	ylnfcheck_parameter(_is_arr_type(ylcar(e)) && ylacd(ylcar(e)));
@@ -318,9 +336,10 @@ YLDEFNF(arr_set, 3, 9999) {
 	at = ylacd( ylcar(e));
 
 	pthread_rwlock_wrlock( &at->m );
-	pv = _arr_get(ylcar(e), ylcddr(e), pthread_rwlock_wrlock);
+	pv = _arr_get(ylcar(e), ylcddr(e), pthread_rwlock_wrlock, &owner);
 
 	if (pv && *pv) { /* *pv cannot be NULL */
+		ylmp_write_barrier(owner, ylcadr(e));
 		*pv = ylcadr(e);
 		pthread_rwlock_unlock( &at->m );
 		return ylcadr(e);
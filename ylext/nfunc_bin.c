@@ -114,9 +114,11 @@ YLDEFNF(subbin, 2, 3) {
     { /* just scope */
         unsigned char*   tmp;
         /* make sub string */
-        tmp = ylmalloc(ei-bi);
+        tmp = ylmp_lo_alloc(ei-bi);
+        if (!tmp)
+		ylnfinterp_fail(YLErr_out_of_memory, "Out Of Memory\n");
         memcpy(tmp, p+bi, ei-bi);
-        return ylacreate_bin(tmp, ei-bi);
+        return ylacreate_lobin(tmp, ei-bi);
     }
 } YLENDNF(subbin)
 
@@ -137,9 +139,9 @@ YLDEFNF(concat_bin, 2, 9999) {
 	yldynb_init(&b, 4096);
 	ylelist_foreach(e) {
 		if (ylais_type(ylcar(e), ylaif_sym())) {
-			sz = strlen(ylasym(ylcar(e)).sym);
+			sz = strlen(ylasymstr(ylcar(e)));
 			if (0 > yldynb_append(&b,
-					     (void*)ylasym(ylcar(e)).sym,
+					     (void*)ylasymstr(ylcar(e)),
 					     (unsigned int)sz))
 				goto bail;
 		} else {
@@ -152,13 +154,14 @@ YLDEFNF(concat_bin, 2, 9999) {
 	{ /* Just scope */
 		unsigned char* p;
 		sz = yldynb_sz(&b);
-		p = ylmalloc(sz);
+		/* result may be very large. */
+		p = ylmp_lo_alloc(sz);
 		if (!p)
 			goto bail;
 		memcpy(p, yldynb_buf(&b), yldynb_sz(&b));
 		yldynb_clean(&b);
 
-		return ylacreate_bin(p, sz);
+		return ylacreate_lobin(p, sz);
 	}
 
  bail:
@@ -175,12 +178,12 @@ YLDEFNF(to_bin, 1, 2) {
 		return ylcar(e);
 
 	else if (ylais_type(ylcar(e), ylaif_sym())) {
-		int            sz = strlen(ylasym(ylcar(e)).sym);
+		int            sz = strlen(ylasymstr(ylcar(e)));
 		unsigned char* b = ylmalloc(sz);
 		if (!b)
 			ylnfinterp_fail (YLErr_out_of_memory,
 					 "Out Of Memory\n");
-		memcpy(b, ylasym(ylcar(e)).sym, sz);
+		memcpy(b, ylasymstr(ylcar(e)), sz);
 		return ylacreate_bin(b, (unsigned int)sz);
 
 	} else if (ylais_type(ylcar(e), ylaif_dbl())) {
@@ -273,22 +273,52 @@ _aif_map_visit(yle_t* e, void* user, int(*cb)(void*, yle_t*)) {
 	return 1;
 }
 
+/*
+ * Memory of map is reported to GC. (See 'ylmp_ext_alloc')
+ * Key and node holding it. (estimated)
+ */
+static inline unsigned long
+_map_entsz(unsigned int keysz) {
+	return keysz + 2 * sizeof(void*);
+}
+
+static int
+_aif_map_size_cb(void* user, const unsigned char* key,
+		 unsigned int sz, void* v) {
+	*(unsigned long*)user += _map_entsz(sz);
+	return 1; /* keep going */
+}
+
+static unsigned long
+_aif_map_size(const yle_t* e) {
+	unsigned long sz = sizeof(struct _amap);
+	pthread_rwlock_rdlock(_amapm(e));
+	(*_amapi(e)->walk)(_amapd(e), &sz, &_aif_map_size_cb);
+	pthread_rwlock_unlock(_amapm(e));
+	return sz;
+}
+
 static void
 _aif_map_clean(yle_t* e) {
+	unsigned long sz = sizeof(struct _amap);
 	/*
 	 * Locking mutex is not used here...
 	 * See comments in '_atrie_destroy' for details.
 	 */
+	(*_amapi(e)->walk)(_amapd(e), &sz, &_aif_map_size_cb);
+	ylmp_ext_free(sz);
 	_amap_destroy ((struct _amap*)ylacd(e));
 }
 
-
 static ylatomif_t _aif_map = {
 	&_aif_map_eq,
 	NULL,
 	&_aif_map_to_string,
 	&_aif_map_visit,
-	&_aif_map_clean
+	&_aif_map_clean,
+	1, /* destroying whole map is heavy */
+	"map",
+	&_aif_map_size
 };
 
 static inline int
@@ -319,6 +349,7 @@ _make_map(yletcxt_t* cxt, yle_t* e, yle_t* a, int pcsz,
 	 * Then trie 't' becomes dangling, if it is not binded to mem block)
 	 */
 	r = ylacreate_cust(&_aif_map, _alloc(d, i));
+	ylmp_ext_alloc(sizeof(struct _amap));
 
 	/* r should be protected from GC - there is eval below! */
 	ylmp_add_bb1(r);
@@ -326,17 +357,20 @@ _make_map(yletcxt_t* cxt, yle_t* e, yle_t* a, int pcsz,
 		yle_t*         v;
 		unsigned char* key;
 		unsigned int   keysz;
+		int            ret;
 		w = ylcar(e);
 		ylelist_foreach(w) {
 			v = yleval(cxt, ylcadar(w), a);
-			key = (unsigned char*)ylasym(ylcaar(w)).sym;
-			keysz = (unsigned int)strlen(ylasym(ylcaar(w)).sym);
-			if (1 == (*_amapi(r)->insert)(_amapd(r),
-						      key,
-						      keysz,
-						      v))
+			key = (unsigned char*)ylasymstr(ylcaar(w));
+			keysz = (unsigned int)strlen(ylasymstr(ylcaar(w)));
+			/* 'r' may become old during evaluation */
+			ylmp_write_barrier(r, v);
+			ret = (*_amapi(r)->insert)(_amapd(r), key, keysz, v);
+			if (1 == ret)
 				yllogW("Map duplicated intial value : %s\n",
-				       ylasym(ylcaar(w)).sym);
+				       ylasymstr(ylcaar(w)));
+			else if (0 == ret)
+				ylmp_ext_alloc(_map_entsz(keysz));
 		}
 	}
 	ylmp_rm_bb1(r);
@@ -392,8 +426,9 @@ YLDEFNF(map_insert, 2, 3) {
 	v = (pcsz > 2)? ylcaddr(e): ylnil();
 
 	pthread_rwlock_wrlock(_amapm(ylcar(e)));
-	key = ylasym(ylcadr(e)).sym;
-	keysz = strlen(ylasym(ylcadr(e)).sym);
+	key = ylasymstr(ylcadr(e));
+	keysz = strlen(ylasymstr(ylcadr(e)));
+	ylmp_write_barrier(ylcar(e), v);
 	r = (*_amapi(ylcar(e))->insert)(_amapd(ylcar(e)),
 					(unsigned char*)key,
 					(unsigned int)keysz,
@@ -405,9 +440,11 @@ YLDEFNF(map_insert, 2, 3) {
         case -1:
 		ylnfinterp_fail(YLErr_func_fail,
 				"Fail to insert to trie : %s\n",
-				ylasym(ylcadr(e)).sym);
+				ylasymstr(ylcadr(e)));
         case 1: return ylt();   /* overwritten */
-        case 0: return ylnil(); /* newly inserted */
+        case 0: /* newly inserted */
+		ylmp_ext_alloc(_map_entsz((unsigned int)keysz));
+		return ylnil();
         default:
 		ylassert(0); /* This should not happen! */
 		return NULL; /* to make compiler be happy */
@@ -423,8 +460,8 @@ YLDEFNF(map_del, 2, 2) {
 			    && ylais_type(ylcadr(e), ylaif_sym()));
 
 	pthread_rwlock_wrlock(_amapm(ylcar(e)));
-	key = ylasym(ylcadr(e)).sym;
-	keysz = strlen(ylasym(ylcadr(e)).sym);
+	key = ylasymstr(ylcadr(e));
+	keysz = strlen(ylasymstr(ylcadr(e)));
 	r = (*_amapi(ylcar(e))->delete)(_amapd(ylcar(e)),
 					(unsigned char*)key,
 					(unsigned int)keysz);
@@ -432,10 +469,12 @@ YLDEFNF(map_del, 2, 2) {
 
 	if (0 > r) {
 		/* invalid slot name */
-		ylnflogW("invalid slot name : %s\n", ylasym(ylcadr(e)).sym);
+		ylnflogW("invalid slot name : %s\n", ylasymstr(ylcadr(e)));
 		return ylnil();
-	} else
+	} else {
+		ylmp_ext_free(_map_entsz((unsigned int)keysz));
 		return ylt();
+	}
 } YLENDNF(map_del)
 
 YLDEFNF(map_get, 2, 2) {
@@ -447,8 +486,8 @@ YLDEFNF(map_get, 2, 2) {
 			    && ylais_type(ylcadr(e), ylaif_sym()));
 
 	pthread_rwlock_rdlock(_amapm(ylcar(e)));
-	key = ylasym(ylcadr(e)).sym;
-	keysz = strlen(ylasym(ylcadr(e)).sym);
+	key = ylasymstr(ylcadr(e));
+	keysz = strlen(ylasymstr(ylcadr(e)));
 	v = (*_amapi(ylcar(e))->get)(_amapd(ylcar(e)),
 				     (unsigned char*)key,
 				     (unsigned int)keysz);
@@ -458,7 +497,7 @@ YLDEFNF(map_get, 2, 2) {
 		return (yle_t*)v;
 	else {
 		/* invalid slot name */
-		ylnflogW("invalid slot name : %s\n", ylasym(ylcadr(e)).sym);
+		ylnflogW("invalid slot name : %s\n", ylasymstr(ylcadr(e)));
 		return ylnil();
 	}
 } YLENDNF(map_get)
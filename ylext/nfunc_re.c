@@ -105,9 +105,9 @@ YLDEFNF(re_match, 3, 3) {
 
 	ylnfcheck_parameter(ylais_type_chain(e, ylaif_sym()));
 
-	pattern = ylasym(ylcar(e)).sym;
-	subject = ylasym(ylcadr(e)).sym;
-	opt = _get_pcre_option(ylasym(ylcaddr(e)).sym);
+	pattern = ylasymstr(ylcar(e));
+	subject = ylasymstr(ylcadr(e));
+	opt = _get_pcre_option(ylasymstr(ylcaddr(e)));
 
 	re = pcre_compile(pattern, opt, &errmsg, &err_offset, NULL);
 	if (!re)
@@ -123,7 +123,7 @@ YLDEFNF(re_match, 3, 3) {
 		       ovect, _OVECCNT);
 
 	/* set head as sentinel */
-	hd = tl = ylmp_block();
+	hd = tl = ylmp_pblock();
 	ylpassign(hd, ylnil(), ylnil());
 	if (rc >= 0) {
 		unsigned int     i, len;
@@ -169,9 +169,9 @@ YLDEFNF(re_replace, 4, 4) {
 	{ /* Just scope */
 		const char   *pattern, *errmsg;
 		int           err_offset, opt;
-		pattern = ylasym(ylcar(e)).sym;
+		pattern = ylasymstr(ylcar(e));
 		/* get pcre option */
-		opt = _get_pcre_option(ylasym(ylcar(ylcdddr(e))).sym);
+		opt = _get_pcre_option(ylasymstr(ylcar(ylcdddr(e))));
 
 		re = pcre_compile(pattern, opt, &errmsg, &err_offset, NULL);
 		if (!re) {
@@ -182,18 +182,18 @@ YLDEFNF(re_replace, 4, 4) {
 		}
 	}
 
-	subst = ylasym(ylcadr(e)).sym;
+	subst = ylasymstr(ylcadr(e));
 	/* get custom option */
-	opt = _get_custom_option(ylasym(ylcar(ylcdddr(e))).sym);
+	opt = _get_custom_option(ylasymstr(ylcar(ylcdddr(e))));
 
 	/* use copied one */
-	subject = ylmalloc(strlen(ylasym(ylcaddr(e)).sym)+1);
+	subject = ylmalloc(strlen(ylasymstr(ylcaddr(e)))+1);
 	if (!subject) {
 		ylnflogE("Out of memory\n");
 		interp_err = YLErr_out_of_memory;
 		goto bail;
 	}
-	strcpy(subject, ylasym(ylcaddr(e)).sym);
+	strcpy(subject, ylasymstr(ylcaddr(e)));
 	subjlen = strlen(subject);
 	offset = 0;
 
@@ -292,9 +292,9 @@ YLDEFNF(re_match, 3, 3) {
 
 	ylnfcheck_parameter(ylais_type_chain(e, ylaif_sym()));
 
-	pattern = ylasym(ylcar(e)).sym;
-	subject = ylasym(ylcadr(e)).sym;
-	opt = _get_re_option(ylasym(ylcaddr(e)).sym);
+	pattern = ylasymstr(ylcar(e));
+	subject = ylasymstr(ylcadr(e));
+	opt = _get_re_option(ylasymstr(ylcaddr(e)));
 
 	re = ylmalloc(sizeof(*re));
 	r = regcomp(re, pattern, opt);
@@ -310,7 +310,7 @@ YLDEFNF(re_match, 3, 3) {
 	r = regexec(re, subject, re->re_nsub + 1, rm, 0);
 
 	/* set head as sentinel */
-	hd = tl = ylmp_block();
+	hd = tl = ylmp_pblock();
 	ylpassign(hd, ylnil(), ylnil());
 	if (!r) {
 		/* Matched!! */
@@ -371,9 +371,9 @@ YLDEFNF(re_replace, 4, 4) {
 	{ /* Just scope */
 		const char   *pattern;
 		int           opt;
-		pattern = ylasym(ylcar(e)).sym;
+		pattern = ylasymstr(ylcar(e));
 		/* get pcre option */
-		opt = _get_re_option(ylasym(ylcar(ylcdddr(e))).sym);
+		opt = _get_re_option(ylasymstr(ylcar(ylcdddr(e))));
 		re = ylmalloc(sizeof(*re));
 
 		r = regcomp(re, pattern, opt);
@@ -385,18 +385,18 @@ YLDEFNF(re_replace, 4, 4) {
 		}
 	}
 
-	subst = ylasym(ylcadr(e)).sym;
+	subst = ylasymstr(ylcadr(e));
 	/* get custom option */
-	opt = _get_custom_option(ylasym(ylcar(ylcdddr(e))).sym);
+	opt = _get_custom_option(ylasymstr(ylcar(ylcdddr(e))));
 
 	/* use copied one */
-	subject = ylmalloc(strlen(ylasym(ylcaddr(e)).sym) + 1);
+	subject = ylmalloc(strlen(ylasymstr(ylcaddr(e))) + 1);
 	if (!subject) {
 		ylnflogE("Out of memory\n");
 		interp_err = YLErr_out_of_memory;
 		goto bail;
 	}
-	strcpy(subject, ylasym(ylcaddr(e)).sym);
+	strcpy(subject, ylasymstr(ylcaddr(e)));
 	subjlen = strlen(subject);
 	offset = 0;
 
@@ -35,7 +35,7 @@
 
 YLDEFNF(strlen, 1, 1) {
 	ylnfcheck_parameter(ylais_type_chain(e, ylaif_sym()));
-	return ylacreate_dbl(strlen(ylasym(ylcar(e)).sym));
+	return ylacreate_dbl(strlen(ylasymstr(ylcar(e))));
 } YLENDNF(strlen)
 
 YLDEFNF(split_to_line, 1, 1) {
@@ -49,7 +49,7 @@ YLDEFNF(split_to_line, 1, 1) {
 	/* get dummy pair head */
 	rt = rh = ylcons(ylnil(), ylnil());
 
-	p = ylasym(ylcar(e)).sym;;
+	p = ylasymstr(ylcar(e));;
 	while (1) {
 		len = 0;
 		ps = p;
@@ -101,7 +101,7 @@ YLDEFNF(char_at, 2, 2) {
 
 	/* check index range */
 	idx = (int)yladbl(ylcadr(e));
-	p = ylasym(ylcar(e)).sym;
+	p = ylasymstr(ylcar(e));
 	len = strlen(p);
 	if (0 > idx || idx >= len)
 		ylnfinterp_fail(YLErr_func_invalid_param,
@@ -118,8 +118,8 @@ YLDEFNF(char_at, 2, 2) {
 YLDEFNF(strcmp, 2, 2) {
 	/* check input parameter */
 	ylnfcheck_parameter(ylais_type_chain(e, ylaif_sym()));
-	return ylacreate_dbl(strcmp(ylasym(ylcar(e)).sym,
-				    ylasym(ylcadr(e)).sym));
+	return ylacreate_dbl(strcmp(ylasymstr(ylcar(e)),
+				    ylasymstr(ylcadr(e))));
 } YLENDNF(strcmp)
 
 
@@ -130,8 +130,8 @@ YLDEFNF(end_with, 2, 2) {
 	/* check input parameter */
 	ylnfcheck_parameter(ylais_type_chain(e, ylaif_sym()));
 
-	pstr = ylasym(ylcar(e)).sym;
-	psub = ylasym(ylcadr(e)).sym;
+	pstr = ylasymstr(ylcar(e));
+	psub = ylasymstr(ylcadr(e));
 	strsz = strlen(pstr);
 	subsz = strlen(psub);
 
@@ -161,8 +161,8 @@ YLDEFNF(start_with, 2, 3) {
 		fromi = (int)yladbl(ylcaddr(e));
 	}
 
-	pstr = ylasym(ylcar(e)).sym;
-	psub = ylasym(ylcadr(e)).sym;
+	pstr = ylasymstr(ylcar(e));
+	psub = ylasymstr(ylcadr(e));
 	strsz = strlen(pstr);
 	subsz = strlen(psub);
 
@@ -197,8 +197,8 @@ YLDEFNF(index_of, 2, 3) {
 		fromi = (int)yladbl(ylcaddr(e));
 	}
 
-	pstr = ylasym(ylcar(e)).sym;
-	psub = ylasym(ylcadr(e)).sym;
+	pstr = ylasymstr(ylcar(e));
+	psub = ylasymstr(ylcadr(e));
 	strsz = strlen(pstr);
 	subsz = strlen(psub);
 
@@ -242,8 +242,8 @@ YLDEFNF(last_index_of, 2, 3) {
 		fromi = (int)yladbl(ylcaddr(e));
 	}
 
-	pstr = ylasym(ylcar(e)).sym;
-	psub = ylasym(ylcadr(e)).sym;
+	pstr = ylasymstr(ylcar(e));
+	psub = ylasymstr(ylcadr(e));
 	strsz = strlen(pstr);
 	subsz = strlen(psub);
 
@@ -291,11 +291,11 @@ YLDEFNF(replace, 3, 3) {
 	/* check input parameter */
 	ylnfcheck_parameter(ylais_type_chain(e, ylaif_sym()));
 
-	pstr = p = ylasym(ylcar(e)).sym;
+	pstr = p = ylasymstr(ylcar(e));
 	lenstr = strlen(p);
-	pold = ylasym(ylcadr(e)).sym;
+	pold = ylasymstr(ylcadr(e));
 	lenold = strlen(pold);
-	pnew = ylasym(ylcaddr(e)).sym;
+	pnew = ylasymstr(ylcaddr(e));
 	lennew = strlen(pnew);
 
 	/* filter trivial case */
@@ -343,7 +343,7 @@ YLDEFNF(substring, 2, 3) {
 			    && (pcsz < 3
 				|| ylais_type(ylcaddr(e), ylaif_dbl())) );
 
-	pstr = ylasym(ylcar(e)).sym;
+	pstr = ylasymstr(ylcar(e));
 	lenstr = strlen(pstr);
 
 	bi = (long long)yladbl(ylcadr(e));
@@ -380,7 +380,7 @@ YLDEFNF(to_lower_case, 1, 1) {
 
 	ylnfcheck_parameter(ylais_type_chain(e, ylaif_sym()));
 
-	p = ylasym(ylcar(e)).sym;
+	p = ylasymstr(ylcar(e));
 	pe = p + strlen(p);
 
 	pb = pbuf = ylmalloc(pe - p + 1);
@@ -406,7 +406,7 @@ YLDEFNF(to_upper_case, 1, 1) {
 
 	ylnfcheck_parameter(ylais_type_chain(e, ylaif_sym()));
 
-	p = ylasym(ylcar(e)).sym;
+	p = ylasymstr(ylcar(e));
 	pe = p + strlen(p);
 
 	pb = pbuf = ylmalloc(pe - p + 1);
@@ -433,7 +433,7 @@ YLDEFNF(trim, 1, 1) {
 
 	ylnfcheck_parameter(ylais_type_chain(e, ylaif_sym()));
 
-	p = ylasym(ylcar(e)).sym;
+	p = ylasymstr(ylcar(e));
 	pend = p + strlen(p);
 
 	/* check leading white space */
@@ -186,6 +186,49 @@ _is_fraw_data_list(yle_t* e) {
 }
 
 /*
+ * Read binary file into large object space. (See 'ylmp_lo_alloc')
+ * Return value and @outsz are same with 'ylutfile_read'.
+ */
+static void*
+_freadlo(unsigned int* outsz, const char* fpath) {
+	FILE*           fh;
+	unsigned char*  buf = NULL;
+	long            sz;
+
+	*outsz = YLErr_io;
+	fh = fopen(fpath, "rb");
+	if (!fh)
+		return NULL;
+	if (0 > fseek(fh, 0, SEEK_END)
+	    || 0 > (sz = ftell(fh))
+	    || 0 > fseek(fh, 0, SEEK_SET))
+		goto bail;
+
+	/* handle special case - empty file */
+	if (0 == sz) {
+		*outsz = YLOk;
+		goto bail;
+	}
+	buf = ylmp_lo_alloc((unsigned long)sz);
+	if (!buf) {
+		*outsz = YLErr_out_of_memory;
+		goto bail;
+	}
+	if (1 != fread(buf, sz, 1, fh)) {
+		ylmp_lo_free(buf);
+		buf = NULL;
+		goto bail;
+	}
+	*outsz = (unsigned int)sz;
+
+ bail:
+	fclose(fh);
+	return buf;
+}
+
+/*
+ * @btext : FALSE to read binary. Then, returned memory is allocated by
+ *          'ylmp_lo_alloc'.
  * @outsz:
  *    in case of fail: 0 means OK, otherwise error!
  */
@@ -196,7 +239,10 @@ _readf(unsigned int* outsz, const char* func, const char* fpath, int btext) {
 
 	if (outsz)
 		*outsz = 1; /* 1 means, 'not 0' */
-	buf = ylutfile_read(&sz, fpath, btext);
+	if (btext)
+		buf = ylutfile_read(&sz, fpath, btext);
+	else
+		buf = _freadlo(&sz, fpath);
 
 	if (buf) {
                 if (outsz)
@@ -252,7 +298,7 @@ _sh_child_process(yle_t* e, FILE* fout) {
 		exit(0);
 	}
 	fclose(fout); /* dupped */
-	execl(__shell, __shell, "-c", ylasym(ylcar(e)).sym, (char*)0);
+	execl(__shell, __shell, "-c", ylasymstr(ylcar(e)), (char*)0);
 	perror("failed to run command\n");
 	exit(1);
 
@@ -368,7 +414,7 @@ YLDEFNF(getenv, 1, 1) {
 	char*  env;
 	/* check input parameter */
 	ylnfcheck_parameter(ylais_type_chain(e, ylaif_sym()));
-	env = getenv(ylasym(ylcar(e)).sym);
+	env = getenv(ylasymstr(ylcar(e)));
 	if (env) {
 		unsigned int    sz = strlen(env);
 		char*           v = ylmalloc(sz+1);
@@ -383,7 +429,7 @@ YLDEFNF(getenv, 1, 1) {
 YLDEFNF(setenv, 2, 2) {
 	/* check input parameter */
 	ylnfcheck_parameter(ylais_type_chain(e, ylaif_sym()));
-	if (0 == setenv(ylasym(ylcar(e)).sym, ylasym(ylcadr(e)).sym, 1))
+	if (0 == setenv(ylasymstr(ylcar(e)), ylasymstr(ylcadr(e)), 1))
 		return ylt();
 	else
 		return ylnil();
@@ -395,9 +441,9 @@ YLDEFNF(getpid, 0, 0) {
 
 YLDEFNF(chdir, 1, 1) {
 	ylnfcheck_parameter(ylais_type_chain(e, ylaif_sym()));
-	if (0 > chdir(ylasym(ylcar(e)).sym)) {
+	if (0 > chdir(ylasymstr(ylcar(e)))) {
 		ylnflogW("Fail to change directory to [ %s ]\n",
-			 ylasym(ylcar(e)).sym);
+			 ylasymstr(ylcar(e)));
 		return ylnil();
 	} else
 		return ylt();
@@ -416,9 +462,9 @@ YLDEFNF(fstat, 1, 1) {
 	struct stat    st;
 	yle_t         *r, *key, *v;
 	ylnfcheck_parameter(ylais_type_chain(e, ylaif_sym()));
-	if (0 > stat(ylasym(ylcar(e)).sym, &st)) {
+	if (0 > stat(ylasymstr(ylcar(e)), &st)) {
 		ylnflogW("Cannot get status of file [%s]\n",
-			 ylasym(ylcar(e)).sym);
+			 ylasymstr(ylcar(e)));
 		return ylnil();
 	}
 
@@ -451,7 +497,7 @@ YLDEFNF(fread, 1, 1) {
 
 	  ylnfcheck_parameter(ylais_type_chain(e, ylaif_sym()));
 
-	  buf = _readf(NULL, "fread", ylasym(ylcar(e)).sym, TRUE);
+	  buf = _readf(NULL, "fread", ylasymstr(ylcar(e)), TRUE);
 	  if (!buf)
 		  goto bail;
 
@@ -476,21 +522,22 @@ YLDEFNF(freadb, 1, 1) {
 
 	ylnfcheck_parameter(ylais_type_chain(e, ylaif_sym()));
 
-	buf = _readf(&sz, "freadb", ylasym(ylcar(e)).sym, FALSE);
+	buf = _readf(&sz, "freadb", ylasymstr(ylcar(e)), FALSE);
 	if (!buf && 0 != sz)
 		goto bail;
 
-	r = ylacreate_bin(buf, sz);
+	/* data may be large. (See '_readf') */
+	r = ylacreate_lobin(buf, sz);
 	buf = NULL; /* to prevent from free */
 
 	if (buf)
-		ylfree(buf);
+		ylmp_lo_free(buf);
 
 	return r;
 
  bail:
 	if (buf)
-		ylfree(buf);
+		ylmp_lo_free(buf);
 
 	return ylnil();
 } YLENDNF(freadb)
@@ -506,22 +553,22 @@ YLDEFNF(fwrite, 2, 2) {
 			    && (ylais_type(dat, ylaif_sym())
 				|| ylais_type(dat, ylaif_bin())));
 
-	fh = fopen(ylasym(ylcar(e)).sym, "w");
+	fh = fopen(ylasymstr(ylcar(e)), "w");
 	if (!fh) {
-		ylnflogW("Cannot open file [%s]\n", ylasym(ylcar(e)).sym);
+		ylnflogW("Cannot open file [%s]\n", ylasymstr(ylcar(e)));
 		goto bail;
 	}
 
 	if ( ylaif_sym() == ylaif(dat) ) {
-		sz = strlen(ylasym(dat).sym);
-		rawdata = ylasym(dat).sym;
+		sz = strlen(ylasymstr(dat));
+		rawdata = ylasymstr(dat);
 	} else { /* Binary case */
 		sz = ylabin(dat).sz;
 		rawdata = ylabin(dat).d;
 	}
 
 	if (sz != fwrite(rawdata, 1, sz, fh)) {
-		ylnflogW("Fail to write file [%s]\n", ylasym(ylcar(e)).sym);
+		ylnflogW("Fail to write file [%s]\n", ylasymstr(ylcar(e)));
 		goto bail;
 	}
 
@@ -542,7 +589,7 @@ YLDEFNF(readdir, 1, 1) {
 	const char*       dpath;
 
 	ylnfcheck_parameter(ylais_type_chain(e, ylaif_sym()));
-	dpath = ylasym(ylcar(e)).sym;
+	dpath = ylasymstr(ylcar(e));
 	dip = opendir(dpath);
 	if (!dip) {
 		ylnflogW("Fail to open directory [%s]\n", dpath);
@@ -748,7 +795,7 @@ _procia_create_child_process(yle_t* e,
 		char** argv = ylmalloc(sizeof(char*)*(pcsz+1));
 		ylassert(argv);
 		for (i=0; i<pcsz; i++) {
-			argv[i] = ylasym(ylcar(e)).sym;
+			argv[i] = ylasymstr(ylcar(e));
 			e = ylcdr(e);
 		}
 		argv[pcsz] = (char*)0;
@@ -846,7 +893,7 @@ YLDEFNF(fraw_open, 2, 2) {
 	/* check input parameter */
 	ylnfcheck_parameter(ylais_type_chain(e, ylaif_sym()));
 	/* flag string */
-	p = ylasym(ylcadr(e)).sym;
+	p = ylasymstr(ylcadr(e));
 	if (_is_in_string(p, 'r'))
 		flags = O_RDONLY;
 	if (_is_in_string(p, 'w'))
@@ -856,7 +903,7 @@ YLDEFNF(fraw_open, 2, 2) {
 		flags |= O_NONBLOCK;
 
 	ylmt_notify_safe(cxt);
-	fd = open( ylasym(ylcar(e)).sym, flags);
+	fd = open( ylasymstr(ylcar(e)), flags);
 	ylmt_notify_unsafe(cxt);
 
 	if (0 > fd) {
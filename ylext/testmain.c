@@ -90,6 +90,9 @@ main(int argc, char* argv[]) {
 	sys.mode    = YLMode_batch;
 	sys.mpsz    = 8*1024;
 	sys.gctp    = 80;
+	sys.gcpause = 0;
+	sys.gcthread = 1;
+	sys.gcregion = 0;
 
 	ylinit(&sys);
 
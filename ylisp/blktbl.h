@@ -41,76 +41,245 @@
  * memory pool
  *     * U(used) / F(free)
  *
- *                fbp
- *             +-------+
- *             |   U   | <- index [sz - 1]
- *             +-------+
- *             |   U   |
- *             +-------+
- *             |  ...  |
- *             +-------+
+ * Pool is array of chunks. Each chunk has fixed number of blocks and its
+ *   own free-block-pointer table. So, pool can grow and shrink in unit of
+ *   chunk.
+ *
+ *      chunk[0]        chunk[1]               chunk[nc - 1]
+ *                fbp             fbp                    fbp
+ *             +-------+       +-------+              +-------+
+ *             |   U   |       |   U   |              |   U   | <- [sz - 1]
+ *             +-------+       +-------+              +-------+
+ *             |  ...  |       |  ...  |     ...      |  ...  |
+ *             +-------+       +-------+              +-------+
+ *      fbi -> |   U   |       |   U   |       fbi -> |   U   |
+ *             +-------+       +-------+              +-------+
+ *             |   F   |       |   F   |              |   F   |
+ *             +-------+       +-------+              +-------+
+ *             |  ...  |       |  ...  |              |  ...  |
+ *             +-------+       +-------+              +-------+
+ *             |   F   |       |   F   |              |   F   | <- [0]
+ *             +-------+       +-------+              +-------+
+ *
+ * Free blocks are taken from the lowest chunk that has free one.
+ * So, used blocks tend to be packed at lower chunks, and higher chunks
+ *   easily become empty - they can be released.
+ *
+ * Young blocks
+ * ------------
+ * Blocks are put back to table only by GC. So, blocks taken after 'wm' is
+ *   set to 'fbi' (aging), are always at [fbi, wm) of each chunk.
+ *
  *             |   U   |
  *             +-------+
- *      fbi -> |   U   |
+ *       wm -> |   U   | <- old
  *             +-------+
- *             |   F   |
+ *             |  ...  | <- young
  *             +-------+
- *             |  ...  |
+ *      fbi -> |   U   | <- young
  *             +-------+
  *             |   F   |
- *             +-------+
- *             |   F   | <- index [0]
- *             +-------+
- *
  */
 
 
 /*
- * block unit of table.
+ * Chunk layout
+ * ------------
+ * Blocks are packed densely - there is no per-block header.
+ * Chunk memory is aligned to its size. First slot of it keeps pointer to
+ *   chunk. So, chunk of block is found from address of block directly.
+ *
+ *     +-------+-------+-------+-- ... --+-------+
+ *     | chunk | [0]   | [1]   |         | [sz-1]|
+ *     +-------+-------+-------+-- ... --+-------+
+ *     ^ aligned to chunk memory size
+ *
+ * Index of free-block-pointer of each block is kept in side table - 'bi'.
+ *
+ * Kind
+ * ----
+ * Each chunk has kind, and blocks are taken only from chunks of requested
+ *   kind. So, blocks of different kind (ex. pair and atom) are kept in
+ *   different chunks. Empty chunk can change its kind.
  */
-struct _mbtblk {
-	unsigned int      i; /**< index of free block pointer */
-	_mbtublk_t        b; /**< MBT User BLocK */
+#define _MBT_NR_KIND 2
+
+/*
+ * chunk of memory block table
+ */
+struct _mbtc {
+	_mbtublk_t*       pool;    /**< blocks */
+	_mbtublk_t**      fbp;     /**< Free Block Pointers */
+	unsigned int*     bi;      /**< index of fbp - side table of blocks */
+	unsigned int      fbi;     /**< Free Block Index - grow to bottom */
+	unsigned int      wm;      /**< Water Mark - fbi at last aging */
+	unsigned int      ci;      /**< index in table */
+	unsigned int      kind;
+	void*             mem;     /**< aligned memory of blocks */
 };
 
 /*
  * memory block table
  */
 struct _mbt {
-	struct _mbtblk*   pool;    /**< pool */
-	_mbtublk_t**      fbp;     /**< Free Block Pointers */
-	int               fbi;     /**< Free Block Index - grow to bottom */
-	unsigned int      sz;      /**< number of blocks in pool */
+	struct _mbtc**    c;       /**< chunks */
+	unsigned int      nc;      /**< number of chunks */
+	unsigned int      ccap;    /**< capacity of chunk pointer array */
+	/* lowest chunk that may have free block - for each kind */
+	unsigned int      lo[_MBT_NR_KIND];
+	unsigned int      csz;     /**< number of blocks in one chunk */
+	unsigned int      nused;   /**< number of used blocks */
+	unsigned long     cmsz;    /**< size of chunk memory. (power of 2) */
 };
 
-static struct _mbt*
-_mbt_create(unsigned int sz) {
-	struct _mbt* bt = ylmalloc(sizeof(*bt));
-	int i;
+/* size of slot keeping pointer to chunk - block alignment is kept */
+#define _MBT_HDRSZ							\
+	(((sizeof(struct _mbtc*) + sizeof(_mbtublk_t) - 1)		\
+	  / sizeof(_mbtublk_t)) * sizeof(_mbtublk_t))
 
-	if (!bt)
-		goto bail_bt;
+static struct _mbtc*
+_mbtc_create(struct _mbt* bt, unsigned int ci, unsigned int kind) {
+	struct _mbtc* c = ylmalloc(sizeof(*c));
+	unsigned int  sz = bt->csz;
+	unsigned int  i;
 
-	bt->pool =  ylmalloc(sizeof(*bt->pool) * sz);
-	if (!bt->pool)
-		goto bail_pool;
+	if (!c)
+		goto bail_c;
 
-	bt->fbp = ylmalloc(sizeof(_mbtublk_t*) * sz);
-	if (!bt->fbp)
+	if (posix_memalign(&c->mem, bt->cmsz, bt->cmsz))
+		goto bail_mem;
+	*(struct _mbtc**)c->mem = c;
+	c->pool = (_mbtublk_t*)((char*)c->mem + _MBT_HDRSZ);
+
+	c->fbp = ylmalloc(sizeof(_mbtublk_t*) * sz);
+	if (!c->fbp)
 		goto bail_fbp;
 
-	bt->fbi = bt->sz = sz;
+	c->bi = ylmalloc(sizeof(*c->bi) * sz);
+	if (!c->bi)
+		goto bail_bi;
+
+	c->fbi = c->wm = sz;
+	c->ci = ci;
+	c->kind = kind;
 
 	for (i = 0; i < sz; i++) {
-		bt->fbp[i] = &bt->pool[i].b;
-		bt->pool[i].i = i;
+		c->fbp[i] = &c->pool[i];
+		c->bi[i] = i;
 	}
 
-	return bt;
+	return c;
 
+ bail_bi:
+	ylfree(c->fbp);
  bail_fbp:
-	ylfree(bt->pool);
- bail_pool:
+	free(c->mem);
+ bail_mem:
+	ylfree(c);
+ bail_c:
+	return NULL; /* OOM */
+}
+
+static inline void
+_mbtc_destroy(struct _mbtc* c) {
+	ylfree(c->bi);
+	ylfree(c->fbp);
+	free(c->mem);
+	ylfree(c);
+}
+
+/*
+ * Add one chunk to the table.
+ * @return : <0 if fails (OOM)
+ */
+static int
+_mbt_grow(struct _mbt* bt, unsigned int kind) {
+	struct _mbtc* c;
+	if (bt->nc >= bt->ccap) {
+		struct _mbtc** cs = ylmalloc(sizeof(*cs) * bt->ccap * 2);
+		if (!cs)
+			return -1;
+		memcpy(cs, bt->c, sizeof(*cs) * bt->nc);
+		ylfree(bt->c);
+		bt->c = cs;
+		bt->ccap *= 2;
+	}
+	c = _mbtc_create(bt, bt->nc, kind);
+	if (!c)
+		return -1;
+	bt->c[bt->nc++] = c;
+	return 0;
+}
+
+/*
+ * Release empty chunks while number of total blocks is larger than 'keep'.
+ * At least one chunk is kept.
+ * @return : number of released chunks.
+ */
+static unsigned int
+_mbt_shrink(struct _mbt* bt, unsigned int keep) {
+	unsigned int ci, k, cnt = 0;
+	ci = bt->nc;
+	while (ci-- > 0
+	       && bt->nc > 1
+	       && (bt->nc - 1) * bt->csz >= keep) {
+		if (bt->c[ci]->fbi < bt->csz)
+			continue; /* there is used block */
+		_mbtc_destroy(bt->c[ci]);
+		bt->nc--;
+		cnt++;
+		if (ci < bt->nc) {
+			/* move last chunk to empty slot */
+			bt->c[ci] = bt->c[bt->nc];
+			bt->c[ci]->ci = ci;
+		}
+	}
+	for (k = 0; k < _MBT_NR_KIND; k++)
+		bt->lo[k] = 0;
+	return cnt;
+}
+
+/*
+ * @csz   : number of blocks in one chunk - hint.
+ *          Chunk memory is rounded up to power of 2, and slots in it are
+ *          used as much as possible.
+ * @nc    : number of chunks at the beginning. (> 0)
+ *          Chunks are kind 0.
+ */
+static struct _mbt*
+_mbt_create(unsigned int csz, unsigned int nc) {
+	struct _mbt* bt = ylmalloc(sizeof(*bt));
+	unsigned int k;
+
+	if (!bt)
+		goto bail_bt;
+
+	bt->ccap = 8;
+	while (bt->ccap < nc)
+		bt->ccap *= 2;
+	bt->c = ylmalloc(sizeof(*bt->c) * bt->ccap);
+	if (!bt->c)
+		goto bail_c;
+
+	bt->nc = bt->nused = 0;
+	for (k = 0; k < _MBT_NR_KIND; k++)
+		bt->lo[k] = 0;
+	bt->cmsz = sizeof(void*);
+	while (bt->cmsz < (unsigned long)csz * sizeof(_mbtublk_t))
+		bt->cmsz <<= 1;
+	bt->csz = (bt->cmsz - _MBT_HDRSZ) / sizeof(_mbtublk_t);
+
+	while (nc--)
+		if (0 > _mbt_grow(bt, 0))
+			goto bail_grow;
+
+	return bt;
+
+ bail_grow:
+	while (bt->nc--)
+		_mbtc_destroy(bt->c[bt->nc]);
+	ylfree(bt->c);
+ bail_c:
 	ylfree(bt);
  bail_bt:
 	return NULL; /* OOM */
@@ -118,60 +287,170 @@ _mbt_create(unsigned int sz) {
 
 static inline void
 _mbt_destroy(struct _mbt* bt) {
-	ylfree(bt->fbp);
-	ylfree(bt->pool);
+	unsigned int i;
+	for (i = 0; i < bt->nc; i++)
+		_mbtc_destroy(bt->c[i]);
+	ylfree(bt->c);
 	ylfree(bt);
 }
 
+static inline unsigned int
+_mbt_sz(struct _mbt* bt) {
+	return bt->nc * bt->csz;
+}
+
+static inline unsigned int
+_mbt_nr_used_blk(struct _mbt* bt) {
+	return bt->nused;
+}
+
+static inline struct _mbtc*
+_mbt_chunk_of(struct _mbt* bt, _mbtublk_t* b) {
+	return *(struct _mbtc**)((uintptr_t)b & ~(uintptr_t)(bt->cmsz - 1));
+}
+
 /*
- * Get free block from block table.
+ * Get free block of 'kind' from chunks whose index is lower than 'lim'.
+ * If there is no chunk of 'kind' having free block, empty chunk of other
+ *   kind is used.
  */
 static inline _mbtublk_t*
-_mbt_get(struct _mbt* bt) {
-	if (bt->fbi <= 0)
+_mbt_get_lim(struct _mbt* bt, unsigned int lim, unsigned int kind) {
+	struct _mbtc* c;
+	unsigned int  ci;
+	while (bt->lo[kind] < lim
+	       && (bt->c[bt->lo[kind]]->kind != kind
+		   || bt->c[bt->lo[kind]]->fbi <= 0))
+		bt->lo[kind]++;
+	if (bt->lo[kind] < lim)
+		c = bt->c[bt->lo[kind]];
+	else {
+		/* find empty chunk */
+		for (ci = 0; ci < lim; ci++)
+			if (bt->c[ci]->fbi >= bt->csz)
+				break;
+		if (ci >= lim)
+			return NULL;
+		c = bt->c[ci];
+		c->kind = kind;
+		bt->lo[kind] = ci;
+	}
+	bt->nused++;
+	return c->fbp[--c->fbi];
+}
+
+/*
+ * Get free block of 'kind' from block table.
+ */
+static inline _mbtublk_t*
+_mbt_get(struct _mbt* bt, unsigned int kind) {
+	if (bt->nused >= _mbt_sz(bt))
 		return NULL; /* not enough mem pool */
-	else
-		return bt->fbp[--bt->fbi];
+	return _mbt_get_lim(bt, bt->nc, kind);
 }
 
-static void
-_mbt_put(struct _mbt* bt, _mbtublk_t* b) {
-	struct _mbtblk* b1 = container_of(b, struct _mbtblk, b);
-	struct _mbtblk* b2 = container_of(bt->fbp[bt->fbi], struct _mbtblk, b);
+/*
+ * Put block back to the chunk.
+ * Counters of table are not updated. So, blocks of different chunks can be
+ *   put back at the same time. (ex. by several threads)
+ * '_mbt_recount' should be called after that.
+ */
+static inline void
+_mbtc_put(struct _mbtc* c, _mbtublk_t* b) {
+	unsigned int i1 = b - c->pool;
+	unsigned int i2 = c->fbp[c->fbi] - c->pool;
 	unsigned int ti; /* temporal index */
 
 	/* swap fbp index */
-	ti = b1->i; b1->i = b2->i; b2->i = ti;
+	ti = c->bi[i1]; c->bi[i1] = c->bi[i2]; c->bi[i2] = ti;
 
 	/* set fbp accordingly */
-	bt->fbp[b1->i] = &b1->b;
-	bt->fbp[b2->i] = &b2->b;
-	bt->fbi++;
+	c->fbp[c->bi[i1]] = b;
+	c->fbp[c->bi[i2]] = &c->pool[i2];
+	c->fbi++;
 }
 
-static inline int
-_mbt_nr_used_blk(struct _mbt* bt) {
-	return bt->sz - bt->fbi;
+/*
+ * Put back old block - at [wm, size of chunk) - of aged chunk.
+ * Block is moved to 'wm' before put. So, young block swapped with it at
+ *   put, goes to 'wm'. And 'wm' is increased to keep it young.
+ */
+static inline void
+_mbtc_put_old(struct _mbtc* c, _mbtublk_t* b) {
+	unsigned int i1 = c->bi[b - c->pool];
+	_mbtublk_t*  o = c->fbp[c->wm];
+
+	/* swap fbp index with the block at 'wm' */
+	c->bi[b - c->pool] = c->wm; c->bi[o - c->pool] = i1;
+	c->fbp[c->wm] = b;
+	c->fbp[i1] = o;
+
+	_mbtc_put(c, b);
+	c->wm++;
 }
 
 /*
- * Iterates pool from start to end (ascending in terms of memory address).
- * @bt    : <struct _mbt*>
- * @i     : <int> index to use for interation.
- * @blk   : <_mbtublk_t*> for iteration
+ * Chunk 'ci' may have free block now.
  */
-#define _mbt_foreach(bt, i, blk)		\
-	for ((i) = 0, (blk) = &(bt)->pool[0].b;	\
-	     (i) < (bt)->sz;			\
-	     (i)++, (blk) = &(bt)->pool[i].b)
+static inline void
+_mbt_lower_lo(struct _mbt* bt, unsigned int ci) {
+	unsigned int kind = bt->c[ci]->kind;
+	if (ci < bt->lo[kind])
+		bt->lo[kind] = ci;
+}
+
+static inline void
+_mbt_put(struct _mbt* bt, _mbtublk_t* b) {
+	struct _mbtc* c = _mbt_chunk_of(bt, b);
+	_mbtc_put(c, b);
+	bt->nused--;
+	_mbt_lower_lo(bt, c->ci);
+}
+
+static inline void
+_mbt_put_old(struct _mbt* bt, _mbtublk_t* b) {
+	struct _mbtc* c = _mbt_chunk_of(bt, b);
+	_mbtc_put_old(c, b);
+	bt->nused--;
+	_mbt_lower_lo(bt, c->ci);
+}
+
+/*
+ * Update counters of table from chunks.
+ */
+static inline void
+_mbt_recount(struct _mbt* bt) {
+	unsigned int i, n = 0;
+	for (i = 0; i < bt->nc; i++)
+		n += bt->csz - bt->c[i]->fbi;
+	bt->nused = n;
+	for (i = 0; i < _MBT_NR_KIND; i++)
+		bt->lo[i] = 0;
+}
 
 /*
  * Order is almost ramdom.
+ * Putting block that is visited now, back to table, is allowed during
+ *   iteration.
+ * (But, 'break' only breaks inner loop - iterating blocks in one chunk.)
  * @bt    : <struct _mbt*>
- * @i     : <int> index to use for interation.
+ * @ci    : <unsigned int> chunk index to use for iteration.
+ * @i     : <unsigned int> index to use for interation.
  * @blk   : <_mbtublk_t*> for iteration
  */
-#define _mbt_foreach_used(bt, i, blk)			\
-	for ((i) = (bt)->fbi, (blk) = (bt)->fbp[i];	\
-	     (i) < (bt)->sz;				\
-	     ++(i), (blk) = (bt)->fbp[i])
+#define _mbt_foreach_used(bt, ci, i, blk)				\
+	for ((ci) = 0; (ci) < (bt)->nc; (ci)++)				\
+		for ((i) = (bt)->c[ci]->fbi;				\
+		     (i) < (bt)->csz					\
+			     && ((blk) = (bt)->c[ci]->fbp[i], 1);	\
+		     ++(i))
+
+/*
+ * Same with '_mbt_foreach_used'. But only young blocks are visited.
+ */
+#define _mbt_foreach_young(bt, ci, i, blk)				\
+	for ((ci) = 0; (ci) < (bt)->nc; (ci)++)				\
+		for ((i) = (bt)->c[ci]->fbi;				\
+		     (i) < (bt)->c[ci]->wm				\
+			     && ((blk) = (bt)->c[ci]->fbp[i], 1);	\
+		     ++(i))
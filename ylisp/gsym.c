@@ -41,7 +41,7 @@ static pthread_mutex_t	 _m;
 static ylerr_t
 _mod_init(void) {
 	pthread_mutex_init(&_m, ylmutexattr());
-	_t = ylslu_create();
+	_t = ylslu_create(1);
 	return YLOk;
 }
 
@@ -61,6 +61,9 @@ ylgsym_insert(const char* sym, short sty, yle_t* e) {
 	_mlock(&_m);
 	ret = ylslu_insert(_t, sym, sty, e);
 	_munlock(&_m);
+	/* global symbol table is not scanned at minor GC */
+	if (ret >= 0 && e && !yleis_gcmark(e))
+		ylmp_escape(e);
 	return ret;
 }
 
@@ -111,6 +114,15 @@ ylgsym_get(short* outty, const char* sym) {
 	return ret;
 }
 
+yle_t*
+ylgsym_get_slot(short* outty, sluv_t** slot, const char* sym) {
+	yle_t*	  ret;
+	_mlock(&_m);
+	ret = ylslu_get_slot(_t, outty, slot, sym);
+	_munlock(&_m);
+	return ret;
+}
+
 void
 ylgsym_gcmark(void) {
 	/* This is called by only 'GC in Mempool' */
@@ -121,6 +133,26 @@ ylgsym_gcmark(void) {
 	}
 }
 
+void
+ylgsym_relocate(yle_t* (*reloc)(yle_t*)) {
+	/* This is called by only 'compaction in Mempool' */
+	if (_t) {
+		_mlock(&_m);
+		ylslu_relocate(_t, reloc);
+		_munlock(&_m);
+	}
+}
+
+void
+ylgsym_walk(void* user,
+	    int (*cb)(void*, const char*, unsigned int, yle_t*)) {
+	if (_t) {
+		_mlock(&_m);
+		ylslu_walk(_t, user, cb);
+		_munlock(&_m);
+	}
+}
+
 int
 ylgsym_auto_complete(const char* start_with,
 		     char* buf, unsigned int bufsz) {
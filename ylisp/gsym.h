@@ -72,6 +72,13 @@ ylgsym_get_description(char* b, unsigned int bsz, const char* sym);
 extern yle_t*
 ylgsym_get(short* outty, const char* sym);
 
+/**
+ * Same with 'ylgsym_get'. But slot of the value is also returned.
+ * (See 'ylslu_get_slot')
+ */
+extern yle_t*
+ylgsym_get_slot(short* outty, sluv_t** slot, const char* sym);
+
 /**
  * Mark memory blocks those can be reachable from Trie for GC.
  * @return: number of memblock that is marked as 'Reachable'
@@ -79,6 +86,21 @@ ylgsym_get(short* outty, const char* sym);
 extern void
 ylgsym_gcmark(void);
 
+/**
+ * Replace values with the ones returned by @reloc.
+ * (See 'ylslu_relocate')
+ */
+extern void
+ylgsym_relocate(yle_t* (*reloc)(yle_t*));
+
+/**
+ * Walk all global symbols. (See 'ylslu_walk')
+ */
+extern void
+ylgsym_walk(void* user,
+	    int (*cb)(void* user, const char* sym, unsigned int symsz,
+		      yle_t* e));
+
 /**
  * get auto-completed-symbol
  * @return:
@@ -0,0 +1,223 @@
+/*****************************************************************************
+ *    Copyright (C) 2010 Younghyung Cho. <yhcting77@gmail.com>
+ *
+ *    This file is part of YLISP.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU Lesser General Public License as
+ *    published by the Free Software Foundation either version 3 of the
+ *    License, or (at your option) any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Lesser General Public License
+ *    (<http://www.gnu.org/licenses/lgpl.html>) for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+/*
+ * Symbol Intern Table
+ * -------------------
+ * String of every symbol atom is interned here.
+ * So, symbols having same name share one canonical string, and comparing
+ *   symbols is just comparing pointers.
+ * Each entry has hash and length of string, and reference count - number
+ *   of symbol atoms using it. Entry is freed when it's not referred anymore.
+ * Canonical string is 's' of entry. So, entry can be found from string
+ *   directly.
+ * Memory of entry is reported to memory pool as external memory of atom.
+ *   (See 'ylmp_ext_alloc')
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "lisp.h"
+
+struct _isym {
+	struct _isym*   next;  /**< next in hash bucket */
+	unsigned int    hash;
+	unsigned int    len;   /**< string length (excluding trailing 0) */
+	unsigned int    ref;   /**< reference count */
+	char            s[1];  /**< canonical string */
+};
+
+/* initial number of hash buckets. should be power of 2 */
+#define _INIT_NR_BUCKET 1024
+
+static struct _isym**   _ht;       /**< hash table */
+static unsigned int     _htsz;     /**< number of buckets */
+static unsigned int     _nr_isym;  /**< number of entries */
+static pthread_mutex_t  _m;
+
+static inline struct _isym*
+_isym_of(const char* isym) {
+	return (struct _isym*)(isym - offsetof(struct _isym, s));
+}
+
+/* FNV-1a */
+static inline unsigned int
+_hash(const char* s, unsigned int len) {
+	unsigned int h = 2166136261U;
+	while (len--)
+		h = (h ^ (unsigned char)*s++) * 16777619U;
+	return h;
+}
+
+/*
+ * Double number of buckets.
+ * If it fails, table keeps working with longer chains.
+ *
+ * Pre-condition
+ *    - _m is locked!
+ */
+static void
+_grow(void) {
+	struct _isym  **nht, *p, *n;
+	unsigned int    i, nsz;
+	nsz = _htsz * 2;
+	nht = ylmalloc(sizeof(*nht) * nsz);
+	if (!nht)
+		return;
+	memset(nht, 0, sizeof(*nht) * nsz);
+	for (i = 0; i < _htsz; i++) {
+		for (p = _ht[i]; p; p = n) {
+			n = p->next;
+			p->next = nht[p->hash & (nsz - 1)];
+			nht[p->hash & (nsz - 1)] = p;
+		}
+	}
+	ylfree(_ht);
+	_ht = nht;
+	_htsz = nsz;
+}
+
+/*
+ * Pre-condition
+ *    - _m is locked!
+ */
+static char*
+_intern(const char* s, unsigned int len, int* bnew) {
+	struct _isym  *p;
+	unsigned int   h;
+	h = _hash(s, len);
+	for (p = _ht[h & (_htsz - 1)]; p; p = p->next) {
+		if (p->hash == h && p->len == len && !memcmp(p->s, s, len)) {
+			p->ref++;
+			return p->s;
+		}
+	}
+	p = ylmalloc(sizeof(*p) + len);
+	if (!p)
+		return NULL;
+	p->hash = h;
+	p->len = len;
+	p->ref = 1;
+	*bnew = 1;
+	memcpy(p->s, s, len);
+	p->s[len] = 0;
+	p->next = _ht[h & (_htsz - 1)];
+	_ht[h & (_htsz - 1)] = p;
+	if (++_nr_isym > _htsz)
+		_grow();
+	return p->s;
+}
+
+char*
+ylsym_intern(const char* s, unsigned int len) {
+	char* r;
+	int   bnew = 0;
+	_mlock(&_m);
+	r = _intern(s, len, &bnew);
+	_munlock(&_m);
+	/*
+	 * Memory pool may be locked while reporting.
+	 * And entry is unreferenced at GC - memory pool is locked.
+	 * So, report it out of '_m' lock to avoid deadlock.
+	 */
+	if (bnew)
+		ylmp_ext_alloc(sizeof(struct _isym) + len);
+	return r;
+}
+
+char*
+ylsym_intern_own(char* s) {
+	char* r;
+	if (!s)
+		return NULL;
+	r = ylsym_intern(s, (unsigned int)strlen(s));
+	ylfree(s);
+	return r;
+}
+
+void
+ylsym_unref(const char* isym) {
+	struct _isym  *e, **pp;
+	/*
+	 * Table is already destroyed.
+	 * (Memory pool may be cleaned after this module, at exit.)
+	 */
+	if (!_ht || !isym)
+		return;
+	_mlock(&_m);
+	e = _isym_of(isym);
+	ylassert(e->ref > 0);
+	if (!--e->ref) {
+		pp = &_ht[e->hash & (_htsz - 1)];
+		while (*pp != e)
+			pp = &(*pp)->next;
+		*pp = e->next;
+		_nr_isym--;
+		ylmp_ext_free(sizeof(*e) + e->len);
+		ylfree(e);
+	}
+	_munlock(&_m);
+}
+
+unsigned int
+ylsym_len(const char* isym) {
+	return _isym_of(isym)->len;
+}
+
+static ylerr_t
+_mod_init(void) {
+	pthread_mutex_init(&_m, ylmutexattr());
+	_htsz = _INIT_NR_BUCKET;
+	_nr_isym = 0;
+	_ht = ylmalloc(sizeof(*_ht) * _htsz);
+	if (!_ht)
+		return YLErr_out_of_memory;
+	memset(_ht, 0, sizeof(*_ht) * _htsz);
+	return YLOk;
+}
+
+static ylerr_t
+_mod_exit(void) {
+	struct _isym  *p, *n;
+	unsigned int   i;
+	_mlock(&_m);
+	/*
+	 * Symbols that are never cleaned (ex. predefined symbols) may still
+	 *   refer entries.
+	 */
+	for (i = 0; i < _htsz; i++) {
+		for (p = _ht[i]; p; p = n) {
+			n = p->next;
+			ylfree(p);
+		}
+	}
+	ylfree(_ht);
+	_ht = NULL;
+	_munlock(&_m);
+	pthread_mutex_destroy(&_m);
+	return YLOk;
+}
+
+YLMODULE_INITFN(intern, _mod_init)
+YLMODULE_EXITFN(intern, _mod_exit)
@@ -57,6 +57,7 @@ ylinterpret_internal(yletcxt_t* cxt,
 	pthread_t		 thd;
 	struct __interpthd_arg	 arg;
 	int			 line = 1;
+	unsigned int		 bbsz;
 
 	if (!stream || 0==streamsz)
 		return YLOk; /* nothing to do */
@@ -89,6 +90,7 @@ ylinterpret_internal(yletcxt_t* cxt,
 	 */
 	_mlock(&cxt->m);
 
+	bbsz = ylstk_size(cxt->bbs);
 	if (pthread_create(&thd, NULL, &ylinterp_automata, &arg)) {
 		ylassert(0);
 		_munlock(&cxt->m);
@@ -115,6 +117,12 @@ ylinterpret_internal(yletcxt_t* cxt,
 	 */
 	ylstk_pop(cxt->thdstk);
 
+	/*
+	 * Thread that fails, exits without removing base blocks.
+	 * (See 'ylinterpret_undefined')
+	 */
+	cxt->bbs->sz = bbsz;
+
 	if (YLOk != ret) {
 		/*
 		 * Close all process resources!! Thread is fails!!
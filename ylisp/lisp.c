@@ -103,12 +103,13 @@ static pthread_mutexattr_t _mattr;
 
 /* --- aif sym --- */
 _DEFAIF_EQ_START(sym) {
-	/* trivial case : compare pointed address first */
-	if (ylasym(e0).sym == ylasym(e1).sym)
-		/* predefined nil can be compared here */
-		return 1;
-	else
-		return (0 == strcmp(ylasym(e0).sym, ylasym(e1).sym))? 1: 0;
+	/*
+	 * strings of symbols are interned, and short string is kept in block
+	 *   with zero padding.
+	 * So, comparing pointer-sized value is enough.
+	 */
+	return (ylasym(e0).str.i == ylasym(e1).str.i
+		&& ylasym_is_short(e0) == ylasym_is_short(e1))? 1: 0;
 } _DEFAIF_EQ_END
 
 #if 0 /* Keep it for future use! */
@@ -124,18 +125,40 @@ _DEFAIF_COPY_START(sym) {
 #endif /* Keep it for future use! */
 
 _DEFAIF_TO_STRING_START(sym) {
-	int slen = strlen(ylasym(e).sym);
+	int slen = ylasym_is_short(e)?
+		strlen(ylasym(e).str.s): ylsym_len(ylasym(e).str.i);
 	if (slen > sz)
 		return -1;
-	memcpy(b, ylasym(e).sym, slen);
+	memcpy(b, ylasymstr(e), slen);
 	return slen;
 } _DEFAIF_TO_STRING_END
 
 _DEFAIF_CLEAN_START(sym) {
-	if (ylasym(e).sym)
-		ylfree(ylasym(e).sym);
+	/* short symbol doesn't refer intern table */
+	if (!ylasym_is_short(e) && ylasym(e).str.i)
+		ylsym_unref(ylasym(e).str.i);
 } _DEFAIF_CLEAN_END
 
+/*
+ * Value of numeric symbol is created at parsing time and kept by symbol.
+ * (See '_classify_num' at parser.c)
+ * Value of call-site cache is not visited. It's also kept by symbol table.
+ */
+static int
+_aif_sym_visit(yle_t* e, void* user, int(*cb)(void*, yle_t*)) {
+	if (YLASym_num == ylestype(e) && !yleis_imm(ylasymc(e)))
+		return (*cb)(user, ylasymc(e));
+	return 1;
+}
+
+static unsigned long
+_aif_sym_size(const yle_t* e) {
+	/* interned string is shared. But, it's counted at each atom */
+	if (!ylasym_is_short(e) && ylasym(e).str.i)
+		return ylsym_len(ylasym(e).str.i) + 1;
+	return 0;
+}
+
 
   /* --- aif nfunc --- */
 _DEFAIF_EQ_START(nfunc) {
@@ -243,10 +266,20 @@ _DEFAIF_TO_STRING_START(bin) {
 } _DEFAIF_TO_STRING_END
 
 _DEFAIF_CLEAN_START(bin) {
-	if (ylabin(e).d)
-		ylfree(ylabin(e).d);
+	ylmp_ext_free(ylabin(e).sz);
+	if (ylabin(e).d) {
+		if (ylestype(e) & YLABin_lo)
+			ylmp_lo_free(ylabin(e).d);
+		else
+			ylfree(ylabin(e).d);
+	}
 } _DEFAIF_CLEAN_END
 
+static unsigned long
+_aif_bin_size(const yle_t* e) {
+	return ylabin(e).sz;
+}
+
   /* --- aif nil --- */
 _DEFAIF_EQ_START(nil) {
 	return (e0 == e1 && e0 == ylnil())? 1: 0;
@@ -290,23 +323,27 @@ _DEFAIF_CLEAN_START(nil) {
 
 
 
-#define _DEFAIF_VAR(sUFFIX)                                             \
+#define _DEFAIF_VAR(sUFFIX, vISIT, fIN, sIZE)                           \
 	static const ylatomif_t _aif_##sUFFIX = {			\
 		&_aif_##sUFFIX##_eq,					\
 		NULL,							\
 		&_aif_##sUFFIX##_to_string,				\
-		NULL,							\
-		&_aif_##sUFFIX##_clean					\
+		vISIT,							\
+		&_aif_##sUFFIX##_clean,					\
+		fIN,							\
+		#sUFFIX,						\
+		sIZE							\
 	};								\
 	const ylatomif_t* const ylg_predefined_aif_##sUFFIX = &_aif_##sUFFIX
 
 
-_DEFAIF_VAR(sym);
-_DEFAIF_VAR(sfunc);
-_DEFAIF_VAR(nfunc);
-_DEFAIF_VAR(dbl);
-_DEFAIF_VAR(bin);
-_DEFAIF_VAR(nil);
+_DEFAIF_VAR(sym, &_aif_sym_visit, 0, &_aif_sym_size);
+_DEFAIF_VAR(sfunc, NULL, 0, NULL);
+_DEFAIF_VAR(nfunc, NULL, 0, NULL);
+_DEFAIF_VAR(dbl, NULL, 0, NULL);
+/* payload of binary may be large. */
+_DEFAIF_VAR(bin, NULL, 1, &_aif_bin_size);
+_DEFAIF_VAR(nil, NULL, 0, NULL);
 
 #undef _DEFAIF_VAR
 
@@ -654,9 +691,9 @@ ylreadv_str(const char* sym, char* buf, unsigned int bsz) {
 	if (!e || ylaif(e) != ylaif_sym())
 		ret = YLErr_invalid_param;
 	else {
-		int len = strlen(ylasym(e).sym) + 1;
+		int len = strlen(ylasymstr(e)) + 1;
 		len = (bsz < len)? bsz: len;
-		memcpy(buf, ylasym(e).sym, len);
+		memcpy(buf, ylasymstr(e), len);
 	}
 
 	_YLREADV_EPILOGUE;
@@ -675,7 +712,7 @@ ylreadv_bin(const char* sym, unsigned char* buf, unsigned int bsz) {
 	else {
 		unsigned int len = ylabin(e).sz;
 		len = (bsz < len)? bsz: len;
-		memcpy(buf, ylasym(e).sym, len);
+		memcpy(buf, ylabin(e).d, len);
 	}
 
 	_YLREADV_EPILOGUE;
@@ -736,8 +773,13 @@ ylinit_thread_context(yletcxt_t* cxt) {
 	cxt->thdstk = ylstk_create(0, NULL);
 	cxt->evalstk = ylstk_create(0, NULL);
 	yllist_init_link(&cxt->pres);
-	cxt->slut = ylslu_create();
+	/* per-thread symbols are never cached. (See '_cache_get' at sfunc.c) */
+	cxt->slut = ylslu_create(0);
+	cxt->bbs = ylstk_create(0, NULL);
 	yldynb_init(&cxt->dynb, 4096);
+	memset(cxt->tlabsz, 0, sizeof(cxt->tlabsz));
+	cxt->tle = cxt->tla = NULL;
+	ylmcache_clear(cxt);
 	return YLOk;
 }
 
@@ -745,6 +787,7 @@ void
 ylexit_thread_context(yletcxt_t* cxt) {
 	yldynb_clean(&cxt->dynb);
 	ylslu_destroy(cxt->slut);
+	ylstk_destroy(cxt->bbs);
 	ylstk_destroy(cxt->evalstk);
 	ylstk_destroy(cxt->thdstk);
 	pthread_mutex_destroy(&cxt->m);
@@ -791,6 +834,9 @@ ylsys_set_default(ylsys_t* sys) {
 	sys->mode      = YLMode_batch;
 	sys->mpsz      = 1024*1024; /* memory pool size */
 	sys->gctp      = 80;
+	sys->gcpause   = 0;
+	sys->gcthread  = 0;
+	sys->gcregion  = 0;
 
 	return 0;
 }
@@ -873,12 +919,12 @@ ylinit(ylsys_t* sysv) {
 	 * '_predefined_xxxx' SHOULD NOT be freed!!!!
 	 * So, passing data pointer is OK
 	 */
-	ylaassign_sym(ylt(),  "t");
-	ylaassign_sym(ylq(),  "quote");
+	ylaassign_csym(ylt(),  "t");
+	ylaassign_csym(ylq(),  "quote");
 
 	/* set nil's type as YLAUnknown -- for easier-programming */
 	yleset_type(ylnil(), YLEAtom);
-	ylaif(ylnil()) = &_aif_nil;
+	yleatom(ylnil()).aif = &_aif_nil;
 
 #define NFUNC(n, s, aif, desc)						\
 	if (YLOk != ylregister_nfunc(YLDEV_VERSION,			\
@@ -70,7 +70,7 @@
 enum {
 	YLASym_def      = 0,     /**< default symbol - ylasymi() */
 	YLASym_mac      = 0x01,  /**< symbol represents macro - ylasymi() */
-	YLASym_num      = 0x02,  /**< symbol represents number- ylasymd() */
+	YLASym_num      = 0x02,  /**< symbol represents number- ylasymc() */
 };
 
 #include "ylisp.h"
@@ -122,6 +122,29 @@ ylregister_exitfn(ylerr_t (*fn)(void));
  *
  **********************************************/
 
+/*
+ * Size of thread local allocation buffer.
+ * (See mempool.c)
+ */
+#define YLTLABSZ 64
+
+/*
+ * Number of entries of macro expansion cache. Should be power of 2.
+ * (See sfunc.c)
+ */
+#define YLMCACHESZ 256
+
+/*
+ * Kind of memory block.
+ * Pairs and atoms are taken from different chunks of pool.
+ * (See mempool.c)
+ */
+enum {
+	YLBKAtom = 0,
+	YLBKPair,
+	YLBKNR,  /**< number of kinds */
+};
+
 /*
  * @pres
  *    Thread may be killed during safe state.
@@ -144,7 +167,24 @@ struct _etcxt {
 					    - for debugging */
 	yllist_link_t          pres;     /**< process resource list */
 	slut_t*                slut;     /**< per-thread Symbol LookUp Table */
+	ylstk_t*               bbs;      /**< base blocks - GC roots
+					    [yle_t*] */
 	yldynb_t               dynb;
+	/* tail call requested by 'yleval_tail' - expression and assoc. list */
+	yle_t*                 tle;
+	yle_t*                 tla;
+	/*
+	 * Macro expansion cache - weak. (See 'ylmcache_gcmark')
+	 * Expansion 'x' of call expression 'e' whose macro value is 'r'.
+	 * 'gen' is generation of cache when 'x' is made.
+	 */
+	struct {
+		yle_t         *e, *r, *x;
+		unsigned int   gen;
+	}                      mc[YLMCACHESZ];
+	/* Thread Local Allocation Buffer - free blocks of each kind */
+	yle_t*                 tlab[YLBKNR][YLTLABSZ];
+	unsigned int           tlabsz[YLBKNR]; /**< number of blocks in 'tlab' */
 
 	const unsigned char*   stream;   /**< target stream interpreted */
 	unsigned int           streamsz; /**< stream size */
@@ -153,12 +193,33 @@ struct _etcxt {
 extern void
 yleclean(yle_t* e);
 
+/*
+ * Mark expansions cached at macro expansion cache of 'cxt' for GC.
+ * Entry whose call expression or macro value is not marked, is dropped.
+ * So, this should be called after all others are marked.
+ */
+extern void
+ylmcache_gcmark(yletcxt_t* cxt);
+
+/*
+ * Drop all expansions cached at macro expansion cache of 'cxt'.
+ */
+extern void
+ylmcache_clear(yletcxt_t* cxt);
+
 /*
  * GC Protection required to caller
  */
 extern yle_t*
 ylapply(yletcxt_t* cxt, yle_t* f, yle_t* args, yle_t* a);
 
+/*
+ * Same with 'ylapply'. But application is evaluated in tail position.
+ * So, this can be used only where 'yleval_tail' can be used.
+ */
+extern yle_t*
+ylapply_tail(yletcxt_t* cxt, yle_t* f, yle_t* args, yle_t* a);
+
 
 #ifdef CONFIG_DBG_EVAL
 /*
@@ -33,6 +33,13 @@
  *
  **************************************/
 
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/mman.h>
 #include "lisp.h"
 
 
@@ -40,163 +47,2051 @@ typedef yle_t _mbtublk_t;
 
 #include "blktbl.h"
 
+/*
+ * Number of blocks in one chunk of memory pool. (approximately)
+ * Memory pool grows and shrinks in unit of chunk.
+ * (See 'blktbl.h' for exact number)
+ */
+#define _CHUNKSZ 4096
+
 /*
  * Memory pool.
  */
 struct _mbt* _m;
 
 /*
- * Stack is enough!
- * Usually, "ylmp_rm_bb" is very close with "ylmp_add_bb".
- * So, searching backward can be very efficient!
- * And there are not many blocks to adjust array
- * (because it's very close to top!)
+ * Generational GC
+ * ---------------
+ * Blocks taken after last GC are 'young'. Blocks survived GC are 'old'.
+ * GC mark of old block is kept until next full GC.
+ * So, minor GC marks only young blocks - marking stops at old block -
+ *   and sweeps only young blocks.
+ * Old block that has reference to young block, is in remembered set.
+ * (See 'ylmp_write_barrier')
+ * Survived young blocks are promoted to old at once.
+ * Full GC is triggered when old blocks are increased more than 'gctp'
+ *   percent of live data at last full GC.
+ */
+
+/*
+ * Number of used blocks just after last GC - number of old blocks.
+ */
+static unsigned int     _live;
+
+/*
+ * Number of used blocks just after last full GC.
+ */
+static unsigned int     _live_full;
+
+/*
+ * External memory
+ * ---------------
+ * Atom may own memory out of pool. (ex. data of binary atom)
+ * A few blocks may hold huge memory. But, it's not visible to triggering
+ *   GC that counts blocks.
+ * So, bytes owned by atoms are reported (See 'ylmp_ext_alloc'), and
+ *   counted as blocks of same size at triggering GC.
+ */
+static volatile unsigned long _ext;      /**< bytes owned by atoms */
+static volatile unsigned long _ext_live; /**< '_ext' just after last GC */
+static unsigned long    _ext_live_full;  /**< '_ext' just after last full GC */
+
+/*
+ * Large object space
+ * ------------------
+ * Payload larger than '_LOSZ' is mapped by 'mmap' directly.
+ * So, it is returned to system as soon as it's freed, and doesn't
+ *   fragment heap. (See 'ylmp_lo_alloc')
+ */
+#define _LOSZ (1024 * 1024)
+
+struct _lohdr {
+	unsigned long      sz;  /**< size requested */
+	unsigned long      pad; /**< to keep alignment of payload */
+};
+
+static volatile unsigned long _lo; /**< bytes mapped for large objects */
+
+/*
+ * Remembered set - old blocks that may refer young blocks.
+ */
+static ylstk_t*         _rs;
+
+/*
+ * Escaped set - young blocks stored to global symbol table.
+ * Global symbol table is scanned only at full GC. At minor GC, blocks in
+ *   this set are used as roots instead. (See 'ylmp_escape')
+ */
+static ylstk_t*         _esc;
+
+/*
+ * Region
+ * ------
+ * In region mode, minor GC is requested at the end of top-level
+ *   expression if enough blocks are taken during the evaluation.
+ * At that moment, temporaries are all garbage. So, minor GC reclaims them
+ *   in bulk and only escaped blocks survive.
+ * (See 'ylmp_region_end')
+ */
+static int              _gcregion; /**< GC is requested by region end */
+
+/*
+ * Compaction
+ * ----------
+ * Live pairs in sparse chunks are moved to dense chunks. So, long-lived
+ *   data (ex. functions in global symbol table) are packed, and chunks
+ *   emptied can be released.
+ * References to moved pair are fixed up from other pairs and symbol
+ *   tables. Blocks that cannot be fixed up are pinned - not moved.
+ *    - pairs reachable from base blocks.
+ *    - pairs referred by atoms. ('visit' doesn't give the slot.)
+ * Native function may keep block in C stack while evaluating. So,
+ *   compaction is run only when no thread is evaluating expression - at
+ *   the end of top-level expression.
+ * If other thread is evaluating, it fails. Then next try is delayed by
+ *   doubling number of region ends to skip. And request is withdrawn
+ *   after '_COMPACT_MAX_TRY' failures. So, safe point is not forced at
+ *   every region end while other thread keeps evaluating.
+ * (See 'ylgc_compact')
+ */
+#define _COMPACT_MAX_TRY 8
+
+static int              _gccompact; /**< compaction is requested */
+static unsigned int     _gcctry;    /**< failed tries of compaction */
+static unsigned int     _gccskip;   /**< region ends left to skip */
+static int              _gcforce;   /**< do full GC at once */
+
+/*
+ * Lazy sweep
+ * ----------
+ * Unmarked blocks are not swept at the end of GC cycle.
+ * When 'ylmp_block' cannot find free block in chunks already swept, chunk
+ *   at cursor is swept. So, cost of sweep is spread over allocation.
+ * Blocks are taken only from chunks already swept. So, blocks allocated
+ *   after marking, are never swept by mistake.
+ * Survivors in chunk become old when the chunk is swept.
+ * Chunks left are swept at once before next GC cycle starts.
+ */
+static int              _gcsweep;  /**< sweep is in progress */
+static volatile unsigned int _gcsci; /**< chunk index - cursor of sweep */
+static unsigned int     _gcsfreed; /**< blocks collected by this sweep */
+static unsigned int     _gcsratio; /**< usage ratio at the end of marking */
+
+/* number of chunks allocated / released since start */
+static unsigned int     _nr_grow;
+static unsigned int     _nr_shrink;
+
+/*
+ * Statistics. (See 'ylgc_stat')
+ */
+static unsigned long long _st_nr_gc;
+static unsigned long long _st_nr_full_gc;
+static unsigned long long _st_collected;
+static unsigned long long _st_alloc;   /**< blocks taken from pool */
+static unsigned long long _st_t0;      /**< time of init (usec) */
+static unsigned int       _st_peak;
+static unsigned int       _st_bbs_max;
+static unsigned long      _st_ext_peak;
+static unsigned int       _st_nr_compact;
+static unsigned long long _st_moved;   /**< pairs moved by compaction */
+
+/*
+ * Base blocks - GC roots registered by 'ylmp_add_bb'.
+ * Each evaluation thread context has its own base block stack.
+ * (See 'bbs' of 'yletcxt_t')
+ * This global stack is used only by thread that is not bound to context.
+ * Stack is enough!
+ * Usually, "ylmp_rm_bb" is very close with "ylmp_add_bb".
+ * So, searching backward can be very efficient!
+ */
+static ylstk_t*         _bbs;   /**< Base-Block-Stack */
+
+
+/* condition - used at GC */
+static pthread_cond_t   _condgc = PTHREAD_COND_INITIALIZER;
+
+static pthread_mutex_t  _mbbs;
+static pthread_mutex_t  _mm;
+
+static int              _gc_enabled = 1; /**< 0 means gc is disabled forcely */
+
+/*
+ * Memory usage ratio! (percent.)
+ */
+static inline int
+_usage_ratio(void) { return _mbt_nr_used_blk(_m) * 100 / _mbt_sz(_m); }
+
+/*
+ * Size of young generation.
+ * GC is triggered when blocks are newly allocated, more than 'gctp' percent
+ *   of 'mpsz', since last GC.
+ */
+static inline unsigned int
+_nursery_sz(void) {
+	return (unsigned int)((unsigned long long)ylmpsz() * ylgctp() / 100);
+}
+
+static inline unsigned int
+_ext_blk(unsigned long bytes) { return bytes / sizeof(yle_t); }
+
+/* external memory newly owned since last GC - in blocks */
+static inline unsigned int
+_ext_young(void) {
+	unsigned long ext = _ext;
+	return ext > _ext_live? _ext_blk(ext - _ext_live): 0;
+}
+
+/* blocks newly taken since last GC - external memory is included */
+static inline unsigned int
+_young(void) { return _mbt_nr_used_blk(_m) - _live + _ext_young(); }
+
+static inline int
+_need_gc(void) { return _young() >= _nursery_sz(); }
+
+/*
+ * Region end requests minor GC only if blocks over
+ *   1/_REGION_RATIO of nursery are taken.
+ * (Running minor GC for a few blocks is waste.)
+ */
+#define _REGION_RATIO 8
+
+/*
+ * Full GC is triggered when old blocks are increased more than 'gctp'
+ *   percent of live data at last full GC.
+ * (If live data is smaller than 'mpsz', 'mpsz' is used instead.)
+ * So, full GC frequency depends on size of live data rather than size of
+ *   pool.
+ */
+static inline int
+_need_full_gc(void) {
+	unsigned long long live = _live + _ext_blk(_ext_live);
+	unsigned long long full = _live_full + _ext_blk(_ext_live_full);
+	unsigned long long base = full > ylmpsz()? full: ylmpsz();
+	return live >= full + base * ylgctp() / 100;
+}
+
+/*
+ * Pre-condition
+ *    - _mm is locked!
+ */
+static int
+_grow(unsigned int kind) {
+	if (0 > _mbt_grow(_m, kind))
+		return -1;
+	_nr_grow++;
+	yllogI("Memory pool grows : %u blocks (%u chunks)\n",
+	       _mbt_sz(_m), _m->nc);
+	return 0;
+}
+
+/*
+ * Release empty chunks if pool is mostly empty.
+ * Pool keeps enough blocks to reach next GC trigger point.
+ *
+ * Pre-condition
+ *    - _mm is locked!
+ */
+static void
+_shrink(void) {
+	unsigned int trigger, cnt;
+	if (_mbt_sz(_m) - _mbt_nr_used_blk(_m) <= _mbt_sz(_m) / 2)
+		return; /* not mostly empty */
+	trigger = _live + _nursery_sz();
+	cnt = _mbt_shrink(_m, trigger + trigger / 4);
+	if (cnt) {
+		_nr_shrink += cnt;
+		yllogI("Memory pool shrinks : %u blocks (%u chunks)\n",
+		       _mbt_sz(_m), _m->nc);
+	}
+}
+
+static void _gc_sweep_step(void);
+static int  _gc_pending(void);
+
+/*
+ * Evaluation threads enter safe state only if safe point is requested.
+ * (See 'ylmt_safepoint')
+ * So, request it if GC is pending.
+ * This is checked whenever blocks are taken from pool.
+ *
+ * Pre-condition
+ *    - _mm is locked!
+ */
+static inline void
+_request_gc(void) {
+	if (_gc_enabled && _gc_pending())
+		ylmt_request_safe(1);
+}
+
+/*
+ * Get free block from pool.
+ * @bgrow : grow pool if there is no free block.
+ * @kind  : _BKAtom or _BKPair
+ *
+ * Pre-condition
+ *    - _mm is locked!
+ */
+static yle_t*
+_get(int bgrow, unsigned int kind) {
+	yle_t* e;
+	while (!(e = _gcsweep?
+		 _mbt_get_lim(_m, _gcsci, kind): _mbt_get(_m, kind))
+	       && _gcsweep)
+		_gc_sweep_step();
+	if (!e && bgrow && !_grow(kind))
+		e = _mbt_get(_m, kind);
+	if (e) {
+		_st_alloc++;
+		if (_mbt_nr_used_blk(_m) > _st_peak)
+			_st_peak = _mbt_nr_used_blk(_m);
+	}
+	return e;
+}
+
+/*
+ * Thread Local Allocation Buffer (TLAB)
+ * -------------------------------------
+ * Each evaluation thread context has small buffer of free blocks.
+ * Block is taken from the buffer without lock. Empty buffer is refilled
+ *   from pool in bulk, under '_mm' lock.
+ * Blocks in buffer are counted as used in pool. So, they are put back to
+ *   pool before sweep, and when context is removed.
+ * (GC runs only when all threads are in safe state. So, buffer is not
+ *   accessed by owner thread while GC.)
+ */
+static pthread_key_t    _cxtkey; /**< context bound to thread */
+
+void
+ylmp_bind_cxt(yletcxt_t* cxt) {
+	pthread_setspecific(_cxtkey, cxt);
+}
+
+/*
+ * Pre-condition
+ *    - _mm is locked!
+ */
+static void
+_tlab_refill(yletcxt_t* cxt, unsigned int kind) {
+	yle_t*        e;
+	yle_t**       tlab = cxt->tlab[kind];
+	unsigned int* sz = &cxt->tlabsz[kind];
+	unsigned int  n;
+	/* buffer should be small enough not to hasten GC too much */
+	n = _nursery_sz() / 4;
+	if (n > YLTLABSZ)
+		n = YLTLABSZ;
+	e = _get(1, kind);
+	if (!e)
+		return;
+	tlab[(*sz)++] = e;
+	while (*sz < n && (e = _get(0, kind)))
+		tlab[(*sz)++] = e;
+}
+
+/*
+ * Pre-condition
+ *    - _mm is locked!
+ */
+static void
+_tlab_release(yletcxt_t* cxt) {
+	unsigned int k;
+	for (k = 0; k < YLBKNR; k++) {
+		/* they are not allocated yet */
+		_st_alloc -= cxt->tlabsz[k];
+		while (cxt->tlabsz[k])
+			_mbt_put(_m, cxt->tlab[k][--cxt->tlabsz[k]]);
+	}
+}
+
+/*
+ * Pairs and atoms are taken from different chunks.
+ * Most of heap is list structure. So, walking list touches less memory.
+ * Kind is just a hint for placement. Block can be used as any kind.
+ */
+static inline yle_t*
+_block(unsigned int kind) {
+	yle_t*     e;
+	yletcxt_t* cxt = pthread_getspecific(_cxtkey);
+	if (cxt && cxt->tlabsz[kind])
+		e = cxt->tlab[kind][--cxt->tlabsz[kind]];
+	else {
+		_mlock(&_mm);
+		if (cxt) {
+			_tlab_refill(cxt, kind);
+			e = cxt->tlabsz[kind]?
+				cxt->tlab[kind][--cxt->tlabsz[kind]]: NULL;
+		} else
+			e = _get(1, kind);
+		_request_gc();
+		_munlock(&_mm);
+	}
+	if (!e) {
+		yllogE("Fail to grow Memory Pool.. Current size is %u\n",
+		       _mbt_sz(_m));
+		ylassert(0);
+	} else {
+		dbg_mem(e->evid = yleval_id(););
+		/*
+		 * initialize block (make car and cdr be NULL)
+		 * (See comments ylmp_clean_block)
+		 * => This is important!
+		 */
+		ylmp_clean_block(e);
+	}
+	return e;
+}
+
+yle_t*
+ylmp_block(void) {
+	return _block(YLBKAtom);
+}
+
+yle_t*
+ylmp_pblock(void) {
+	return _block(YLBKPair);
+}
+
+/*
+ * Remove base block from stack.
+ * Searching backward from the top. So, removing in reverse order of
+ *   adding, is O(1).
+ * This modifies stack directly!
+ * @return : 0 if not found.
+ */
+static int
+_rm_bb(ylstk_t* s, yle_t* e) {
+	register int i;
+	i = ylstk_size(s)-1; /* top */
+	if (i >= 0 && s->item[i] == (void*)e) {
+		s->sz--;
+		return 1;
+	}
+	for (;i >= 0; i --) {
+		if (s->item[i] == (void*)e) {
+			/* we found! */
+			memmove(&s->item[i], &s->item[i+1],
+				sizeof(s->item[i])*(ylstk_size(s)-i-1));
+			s->sz--;
+			return 1; /* done! */
+		}
+	}
+	return 0;
+}
+
+void
+ylmp_add_bb(yle_t* e) {
+	yletcxt_t* cxt = pthread_getspecific(_cxtkey);
+	if (cxt)
+		ylstk_push(cxt->bbs, e);
+	else {
+		_mlock(&_mbbs);
+		ylstk_push(_bbs, e);
+		_munlock(&_mbbs);
+	}
+}
+
+void
+ylmp_rm_bb(yle_t* e) {
+	int        r;
+	yletcxt_t* cxt = pthread_getspecific(_cxtkey);
+	if (cxt)
+		r = _rm_bb(cxt->bbs, e);
+	else {
+		_mlock(&_mbbs);
+		r = _rm_bb(_bbs, e);
+		_munlock(&_mbbs);
+	}
+	if (!r)
+		yllogW("WARN!! Try to remove unregistered base block! : %p\n",
+		       e);
+}
+
+void
+ylmp_clean_bb(void) {
+	yletcxt_t* cxt = pthread_getspecific(_cxtkey);
+	if (cxt)
+		ylstk_clean(cxt->bbs);
+	else {
+		_mlock(&_mbbs);
+		ylstk_clean(_bbs);
+		_munlock(&_mbbs);
+	}
+}
+
+/* =========================
+ * GC !!! (START)
+ * =========================*/
+/*
+ * Incremental GC
+ * --------------
+ * Tri-color marking is used.
+ *     white : GC mark is not set.
+ *     grey  : GC mark is set, and it's in grey stack.
+ *     black : GC mark is set, and it's not in grey stack.
+ * GC cycle consists of phases and each phase is done in slices at the
+ *   moment that all threads are in safe state.
+ * Length of one slice is limited by 'gcpause' of system parameter.
+ *     [Clear] -> Mark -> Remark & Sweep
+ *     (Clear phase is only for full GC - clear mark of all blocks.)
+ * Evaluation runs between slices. So, black block may get reference of
+ *   white block. 'ylmp_write_barrier' puts these black blocks into
+ *   remembered set. And they are re-scanned at remark.
+ * Roots are also re-scanned at remark. So, blocks allocated during cycle
+ *   and reachable from roots, survive.
+ */
+enum {
+	_GCIdle = 0,
+	_GCClear,
+	_GCMark,
+};
+
+static int              _gcphase;  /**< current phase of GC cycle */
+static int              _gcfull;   /**< current cycle is full GC? */
+static unsigned int     _gccci;    /**< chunk index - cursor of clear phase */
+
+/*
+ * Prefetch queue of marking.
+ * Block is not shaded as soon as it is found. It is prefetched and put
+ *   into this FIFO. And shaded when it is pushed out from FIFO.
+ * So, block header is in cache when it is shaded.
+ */
+#define _PFQSZ 8 /* should be power of 2 */
+
+#ifdef __GNUC__
+#       define _prefetch(p) __builtin_prefetch(p, 1)
+#else /* __GNUC__ */
+#       define _prefetch(p) do {} while (0)
+#endif /* __GNUC__ */
+
+/*
+ * Parallel GC
+ * -----------
+ * Marking and sweeping are done by several GC workers.
+ * Worker 0 is the thread running GC. Others are threads only for GC.
+ * ('gcthread' of system parameter)
+ *
+ * Mark : Each worker has private grey stack and shared deque.
+ *        If shared deque is empty, worker moves bottom half of private
+ *          stack to it. Worker that is out of work, steals grey blocks
+ *          from shared deque of other workers.
+ *        GC mark is set atomically. So, block is scanned only once.
+ *        Marking ends when all workers are out of work.
+ * Sweep: Chunks are distributed to workers. Block is put back only to
+ *          its own chunk. So, workers don't conflict with each other.
+ *        But, clean function of custom atom may access other blocks.
+ *        (ex. 'procia' of ylext cleans it's pipes.)
+ *        These are cleaned by worker 0 after sweep.
+ *
+ * Parallel GC is used only if there is enough work to do.
+ * Starting workers is not free.
+ */
+struct _gcw {
+	unsigned int      id;
+	pthread_t         thd;
+	ylstk_t*          ps;   /**< private grey stack */
+	ylstk_t*          sd;   /**< shared deque - other workers steal it */
+	pthread_mutex_t   msd;  /**< lock for 'sd' */
+	yle_t*            pfq[_PFQSZ]; /**< prefetch queue */
+	unsigned int      pfqi;
+	ylstk_t*          dfr;  /**< atoms whose clean is deferred */
+	unsigned int      cnt;  /**< number of blocks swept */
+};
+
+#define _GCW_MAX       64
+/* private grey stack larger than this, is shared */
+#define _GCW_SHARE_MIN 64
+/* blocks to mark/sweep should be more than this for parallel GC */
+#define _GCW_PAR_MIN   (4 * _CHUNKSZ)
+
+enum {
+	_GCJMark = 0,
+	_GCJSweep,
+	_GCJExit,
+};
+
+static struct _gcw*     _gcws;     /**< GC workers */
+static unsigned int     _nr_gcw;   /**< number of GC workers */
+static unsigned int     _gcpar;    /**< number of workers in current job */
+
+static pthread_mutex_t  _mgcw;
+static pthread_cond_t   _condgcw  = PTHREAD_COND_INITIALIZER; /* job */
+static pthread_cond_t   _condgcwd = PTHREAD_COND_INITIALIZER; /* done */
+static int              _gcjob;    /**< job for workers */
+static unsigned int     _gcjseq;   /**< sequence number of job */
+static unsigned int     _gcjrun;   /**< number of workers running job */
+
+static volatile int     _gcactive; /**< number of workers having grey block */
+static volatile int     _gcstop;   /**< stop marking - deadline */
+static unsigned long long _gcdeadline;
+
+/* end time of last GC slice (usec) */
+static unsigned long long _gcslice_end;
+
+/*
+ * Histogram of GC pause time.
+ * Log-linear bucket is used.
+ * value < 16 usec     : one bucket per usec.
+ * value >= 16 usec    : 8 buckets per power of 2.
+ */
+#define _PHIST_LINEAR  16
+#define _PHIST_SUB     8   /* number of sub bucket in power of 2 */
+#define _PHIST_NR      (_PHIST_LINEAR + (64 - 4) * _PHIST_SUB)
+
+static unsigned long long _phist[_PHIST_NR];
+static unsigned long long _nr_pause;
+static unsigned long long _max_pause;
+static unsigned long long _sum_pause;
+
+static inline unsigned long long
+_now_us(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec * 1000000ULL
+		+ (unsigned long long)ts.tv_nsec / 1000ULL;
+}
+
+static inline int
+_phist_bucket(unsigned long long us) {
+	int exp = 0;
+	unsigned long long v = us;
+	if (us < _PHIST_LINEAR)
+		return (int)us;
+	while (v >>= 1)
+		exp++;
+	return _PHIST_LINEAR + (exp - 4) * _PHIST_SUB
+		+ (int)((us >> (exp - 3)) & (_PHIST_SUB - 1));
+}
+
+/*
+ * Upper bound of values in the bucket.
+ */
+static inline unsigned long long
+_phist_value(int b) {
+	int exp, sub;
+	if (b < _PHIST_LINEAR)
+		return (unsigned long long)b;
+	b -= _PHIST_LINEAR;
+	exp = b / _PHIST_SUB + 4;
+	sub = b % _PHIST_SUB;
+	return ((unsigned long long)(_PHIST_SUB + sub + 1) << (exp - 3)) - 1;
+}
+
+static inline void
+_pause_record(unsigned long long us) {
+	_phist[_phist_bucket(us)]++;
+	_nr_pause++;
+	_sum_pause += us;
+	if (us > _max_pause)
+		_max_pause = us;
+}
+
+/*
+ * Pre-condition
+ *    - _mm is locked!
+ */
+static unsigned long long
+_pause_percentile(unsigned int pct) {
+	unsigned long long n, target, r = 0;
+	int                b;
+	if (pct > 100)
+		pct = 100;
+	if (_nr_pause) {
+		target = (_nr_pause * pct + 99) / 100;
+		if (!target)
+			target = 1;
+		n = 0;
+		for (b = 0; b < _PHIST_NR; b++) {
+			n += _phist[b];
+			if (n >= target)
+				break;
+		}
+		r = _phist_value(b);
+		if (r > _max_pause)
+			r = _max_pause;
+	}
+	return r;
+}
+
+unsigned long long
+ylgc_pause_percentile(unsigned int pct) {
+	unsigned long long r;
+	_mlock(&_mm);
+	r = _pause_percentile(pct);
+	_munlock(&_mm);
+	return r;
+}
+
+void
+ylgc_stat(ylgcstat_t* st) {
+	unsigned long long t;
+	_mlock(&_mm);
+	st->nr_gc = _st_nr_gc;
+	st->nr_full_gc = _st_nr_full_gc;
+	st->collected = _st_collected;
+	st->alloc = _st_alloc;
+	t = _now_us() - _st_t0;
+	st->alloc_rate = t? _st_alloc * 1000000ULL / t: 0;
+	st->nr_pause = _nr_pause;
+	st->pause_total = _sum_pause;
+	st->pause_max = _max_pause;
+	st->pause_p50 = _pause_percentile(50);
+	st->pause_p90 = _pause_percentile(90);
+	st->pause_p99 = _pause_percentile(99);
+	st->used = _mbt_nr_used_blk(_m);
+	st->peak = _st_peak;
+	st->live = _live;
+	st->poolsz = _mbt_sz(_m);
+	st->nr_grow = _nr_grow;
+	st->nr_shrink = _nr_shrink;
+	st->bbs_max = _st_bbs_max;
+	st->ext = _ext;
+	st->ext_peak = _st_ext_peak;
+	st->lo = _lo;
+	st->nr_compact = _st_nr_compact;
+	st->moved = _st_moved;
+	_munlock(&_mm);
+}
+
+void
+ylmp_ext_alloc(unsigned long sz) {
+	unsigned long ext = __sync_add_and_fetch(&_ext, sz);
+	if (ext > _st_ext_peak)
+		_st_ext_peak = ext; /* statistics. race is ignored */
+	/*
+	 * Blocks may not be taken from pool for a long time - TLAB.
+	 * So, GC is requested here too.
+	 */
+	if (_ext_young() >= _nursery_sz()) {
+		_mlock(&_mm);
+		_request_gc();
+		_munlock(&_mm);
+	}
+}
+
+void
+ylmp_ext_free(unsigned long sz) {
+	unsigned long o, n;
+	__sync_fetch_and_sub(&_ext, sz);
+	/*
+	 * External memory may be freed out of '_mm' lock.
+	 *   (ex. atom cleaned at finalizer thread, symbol intern table.)
+	 * So, '_ext_live' is updated by CAS. It doesn't go below 0.
+	 */
+	do {
+		o = _ext_live;
+		n = o > sz? o - sz: 0;
+	} while (!__sync_bool_compare_and_swap(&_ext_live, o, n));
+}
+
+void*
+ylmp_lo_alloc(unsigned long sz) {
+	struct _lohdr* h;
+	unsigned long  msz = sizeof(*h) + sz;
+	if (sz < _LOSZ)
+		h = ylmalloc(msz);
+	else {
+		h = mmap(NULL, msz, PROT_READ | PROT_WRITE,
+			 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (MAP_FAILED == h)
+			h = NULL;
+		else
+			__sync_fetch_and_add(&_lo, msz);
+	}
+	if (!h)
+		return NULL;
+	h->sz = sz;
+	return h + 1;
+}
+
+void
+ylmp_lo_free(void* p) {
+	struct _lohdr* h;
+	if (!p)
+		return;
+	h = (struct _lohdr*)p - 1;
+	if (h->sz < _LOSZ)
+		ylfree(h);
+	else {
+		__sync_fetch_and_sub(&_lo, sizeof(*h) + h->sz);
+		munmap(h, sizeof(*h) + h->sz);
+	}
+}
+
+/*
+ * white -> grey
+ * Atom that doesn't refer other blocks, has nothing to scan.
+ * So, it becomes black directly.
+ */
+static inline void
+_shade(struct _gcw* w, yle_t* e) {
+	if (yleis_gcmark(e))
+		return;
+	if (_gcpar > 1) {
+		/* other worker may shade it at the same time */
+		if (__sync_fetch_and_or(&e->t, YLEGCMark) & YLEGCMark)
+			return;
+	} else
+		yleset_gcmark(e);
+	if (!yleis_atom(e) || ylaif(e)->visit)
+		ylstk_push(w->ps, e);
+}
+
+/*
+ * shade via prefetch queue.
+ */
+static inline void
+_shade_pf(struct _gcw* w, yle_t* e) {
+	yle_t* o;
+	/* immediate number is not block */
+	if (yleis_imm(e))
+		return;
+	_prefetch(e);
+	o = w->pfq[w->pfqi];
+	w->pfq[w->pfqi] = e;
+	w->pfqi = (w->pfqi + 1) & (_PFQSZ - 1);
+	if (o)
+		_shade(w, o);
+}
+
+/*
+ * @return : 1 if there was block in queue.
+ */
+static int
+_pfq_flush(struct _gcw* w) {
+	int i, r = 0;
+	for (i = 0; i < _PFQSZ; i++) {
+		if (w->pfq[i]) {
+			_shade(w, w->pfq[i]);
+			w->pfq[i] = NULL;
+			r = 1;
+		}
+	}
+	return r;
+}
+
+static int
+_shade_cb(void* user, yle_t* e) {
+	_shade_pf((struct _gcw*)user, e);
+	return 1;
+}
+
+void
+ylmp_gcmark(yle_t* e) {
+	_shade(&_gcws[0], e);
+}
+
+static inline void
+_scan(struct _gcw* w, yle_t* e) {
+	if (yleis_atom(e)) {
+		if (ylaif(e)->visit)
+			ylaif(e)->visit(e, w, &_shade_cb);
+	} else {
+		ylassert((ylpcar(e) && ylpcdr(e))
+			 || (!ylpcar(e) && !ylpcdr(e)));
+		if (ylpcar(e)) {
+			_shade_pf(w, ylpcar(e));
+			_shade_pf(w, ylpcdr(e));
+		}
+	}
+}
+
+/*
+ * Move bottom half of private stack to shared deque, if shared deque is
+ *   empty.
+ * Only owner pushes to shared deque. So, reading size without lock is ok.
+ */
+static inline void
+_gcw_share(struct _gcw* w) {
+	unsigned int i, n;
+	if (ylstk_size(w->ps) < _GCW_SHARE_MIN || ylstk_size(w->sd))
+		return;
+	n = ylstk_size(w->ps) / 2;
+	_mlock(&w->msd);
+	for (i = 0; i < n; i++)
+		ylstk_push(w->sd, w->ps->item[i]);
+	_munlock(&w->msd);
+	memmove(w->ps->item, &w->ps->item[n],
+		sizeof(w->ps->item[0]) * (ylstk_size(w->ps) - n));
+	w->ps->sz -= n;
+}
+
+/*
+ * Take back grey blocks from it's own shared deque.
+ * @return : 1 if there is grey block in private stack.
+ */
+static int
+_gcw_unshare(struct _gcw* w) {
+	if (!ylstk_size(w->sd))
+		return 0;
+	_mlock(&w->msd);
+	while (ylstk_size(w->sd))
+		ylstk_push(w->ps, ylstk_pop(w->sd));
+	_munlock(&w->msd);
+	/* other worker may steal all of them before locking */
+	return !!ylstk_size(w->ps);
+}
+
+/*
+ * Steal half of shared deque of other worker.
+ * Worker becomes active before releasing lock of victim's deque.
+ * So, '_gcactive' cannot be 0 while there is grey block.
+ * @return : 1 if success.
+ */
+static int
+_gcw_steal(struct _gcw* w) {
+	struct _gcw* v;
+	unsigned int k, n;
+	for (k = 1; k < _gcpar; k++) {
+		v = &_gcws[(w->id + k) % _gcpar];
+		if (!ylstk_size(v->sd))
+			continue;
+		_mlock(&v->msd);
+		if (ylstk_size(v->sd)) {
+			__sync_add_and_fetch(&_gcactive, 1);
+			n = (ylstk_size(v->sd) + 1) / 2;
+			while (n--)
+				ylstk_push(w->ps, ylstk_pop(v->sd));
+			_munlock(&v->msd);
+			return 1;
+		}
+		_munlock(&v->msd);
+	}
+	return 0;
+}
+
+static inline int
+_gcw_should_stop(void) {
+	if (_gcstop)
+		return 1;
+	/* checking time is not cheap. */
+	if (_gcdeadline && _now_us() >= _gcdeadline) {
+		_gcstop = 1;
+		return 1;
+	}
+	return 0;
+}
+
+/*
+ * Mark job of worker.
+ * If deadline is reached, grey blocks are left in stack/deque of worker.
+ */
+static void
+_gcw_mark(struct _gcw* w) {
+	unsigned int n = 0;
+	for (;;) {
+		while (ylstk_size(w->ps) || _gcw_unshare(w)) {
+			_scan(w, ylstk_pop(w->ps));
+			if (!(++n & 0xff) && _gcw_should_stop()) {
+				/*
+				 * Blocks in prefetch queue are referred by
+				 *   black block. They should be grey.
+				 */
+				_pfq_flush(w);
+				return;
+			}
+			if (_gcpar > 1)
+				_gcw_share(w);
+		}
+		if (_pfq_flush(w))
+			continue;
+		if (_gcpar <= 1)
+			return; /* done */
+		/* out of work */
+		__sync_sub_and_fetch(&_gcactive, 1);
+		for (;;) {
+			if (_gcstop)
+				return;
+			if (_gcw_steal(w))
+				break;
+			if (!_gcactive)
+				return; /* done */
+			sched_yield();
+		}
+	}
+}
+
+/*
+ * Finalizer
+ * ---------
+ * 'clean' of dead atom whose interface has 'fin', is not run while
+ *   sweeping. It's run by finalizer thread. So, releasing large resource
+ *   (ex. whole map) doesn't stretch GC pause or allocation.
+ * Block is put back to pool at once. Copy of it is queued instead.
+ * (See 'fin' of 'ylatomif_t')
+ */
+#define _FINBSZ 64 /* blocks in one batch */
+
+struct _finb {
+	struct _finb*     next;
+	unsigned int      n;
+	yle_t             e[_FINBSZ];
+};
+
+static pthread_t        _finthd;
+static int              _finon;    /**< finalizer thread is running */
+static pthread_mutex_t  _mfin;
+static pthread_cond_t   _condfin  = PTHREAD_COND_INITIALIZER; /* queued */
+static pthread_cond_t   _condfind = PTHREAD_COND_INITIALIZER; /* done */
+static struct _finb*    _finq;     /**< batches queued. head is filled */
+static int              _finbusy;  /**< finalizer is cleaning */
+static int              _finexit;
+
+static void*
+_fin_main(void* arg) {
+	struct _finb  *b, *n;
+	unsigned int   i;
+	_mlock(&_mfin);
+	for (;;) {
+		while (!_finq && !_finexit)
+			if (pthread_cond_wait(&_condfin, &_mfin))
+				ylassert(0);
+		if (!_finq)
+			break; /* exit */
+		b = _finq;
+		_finq = NULL;
+		_finbusy = 1;
+		_munlock(&_mfin);
+		for (; b; b = n) {
+			n = b->next;
+			for (i = 0; i < b->n; i++)
+				yleclean(&b->e[i]);
+			ylfree(b);
+		}
+		_mlock(&_mfin);
+		_finbusy = 0;
+		pthread_cond_broadcast(&_condfind);
+	}
+	_munlock(&_mfin);
+	return NULL;
+}
+
+/*
+ * Queue dead atom to finalizer, and make block clean.
+ * This can be called by several GC workers at the same time.
+ */
+static void
+_fin_push(yle_t* e) {
+	struct _finb* b;
+	_mlock(&_mfin);
+	b = _finq;
+	if (_finon && (!b || _FINBSZ == b->n)) {
+		b = ylmalloc(sizeof(*b));
+		if (b) {
+			b->next = _finq;
+			b->n = 0;
+			_finq = b;
+		}
+	}
+	if (!_finon || !b) {
+		/* no finalizer or OOM. Clean it here. */
+		_munlock(&_mfin);
+		yleclean(e);
+		return;
+	}
+	if (!b->n && !b->next)
+		pthread_cond_signal(&_condfin);
+	memcpy(&b->e[b->n++], e, sizeof(*e));
+	_munlock(&_mfin);
+	ylmp_clean_block(e);
+}
+
+void
+ylmp_fin_flush(void) {
+	_mlock(&_mfin);
+	while (_finq || _finbusy)
+		if (pthread_cond_wait(&_condfind, &_mfin))
+			ylassert(0);
+	_munlock(&_mfin);
+}
+
+static void
+_fin_create(void) {
+	pthread_mutex_init(&_mfin, ylmutexattr());
+	_finq = NULL;
+	_finbusy = _finexit = 0;
+	_finon = !pthread_create(&_finthd, NULL, &_fin_main, NULL);
+	if (!_finon)
+		yllogW("Fail to create finalizer thread!"
+		       " Atoms are cleaned at GC\n");
+}
+
+static void
+_fin_destroy(void) {
+	if (_finon) {
+		_mlock(&_mfin);
+		_finexit = 1;
+		pthread_cond_signal(&_condfin);
+		_munlock(&_mfin);
+		/* finalizer exits after cleaning all queued atoms */
+		pthread_join(_finthd, NULL);
+		_finon = 0;
+	}
+	pthread_mutex_destroy(&_mfin);
+}
+
+/*
+ * custom atom may access other blocks at clean.
+ */
+static inline int
+_is_simple_atom(yle_t* e) {
+	return ylais_type(e, ylaif_sym())
+		|| ylais_type(e, ylaif_dbl())
+		|| ylais_type(e, ylaif_nfunc())
+		|| ylais_type(e, ylaif_sfunc())
+		|| ylais_type(e, ylaif_bin());
+}
+
+/*
+ * Sweep unmarked blocks in the chunk.
+ * Block at 'i' is swapped with block at 'fbi' at put.
+ * And block at 'fbi' is already visited.
+ * @defer : clean of custom atom is deferred.
+ */
+static void
+_sweep_chunk(struct _gcw* w, struct _mbtc* c, int defer) {
+	yle_t*        e;
+	unsigned int  i, end;
+	end = _gcfull? _m->csz: c->wm;
+	for (i = c->fbi; i < end; i++) {
+		e = c->fbp[i];
+		if (yleis_gcmark(e))
+			continue;
+		w->cnt++;
+		ylassert(e != ylnil() && e != ylt() && e != ylq());
+		if (yleis_atom(e) && ylaif(e)->fin)
+			_fin_push(e);
+		else if (defer && yleis_atom(e) && !_is_simple_atom(e)) {
+			ylstk_push(w->dfr, e);
+			continue;
+		} else
+			yleclean(e);
+		_mbtc_put(c, e);
+	}
+}
+
+/*
+ * Sweep job of worker.
+ * Worker takes chunk one by one from cursor.
+ */
+static void
+_gcw_sweep(struct _gcw* w) {
+	unsigned int  ci;
+	for (;;) {
+		ci = _gcpar > 1? __sync_fetch_and_add(&_gcsci, 1): _gcsci++;
+		if (ci >= _m->nc)
+			return;
+		_sweep_chunk(w, _m->c[ci], 1);
+	}
+}
+
+static void
+_gcw_run(struct _gcw* w, int job) {
+	switch (job) {
+	case _GCJMark:  _gcw_mark(w);  break;
+	case _GCJSweep: _gcw_sweep(w); break;
+	default: ylassert(0);
+	}
+}
+
+static void*
+_gcw_main(void* arg) {
+	struct _gcw* w = (struct _gcw*)arg;
+	unsigned int seq;
+	int          job;
+
+	/*
+	 * Worker may start after first job is requested.
+	 * (Job sequence starts from 0.)
+	 */
+	seq = 0;
+	_mlock(&_mgcw);
+	for (;;) {
+		while (seq == _gcjseq)
+			if (pthread_cond_wait(&_condgcw, &_mgcw))
+				ylassert(0);
+		seq = _gcjseq;
+		job = _gcjob;
+		if (_GCJExit == job)
+			break;
+		_munlock(&_mgcw);
+		_gcw_run(w, job);
+		_mlock(&_mgcw);
+		if (!--_gcjrun)
+			pthread_cond_signal(&_condgcwd);
+	}
+	_munlock(&_mgcw);
+	return NULL;
+}
+
+/*
+ * Run job with all workers, and wait until all of them are done.
+ * Worker 0 is caller itself.
+ */
+static void
+_gcw_par_run(int job) {
+	_gcpar = _nr_gcw;
+	_mlock(&_mgcw);
+	_gcjob = job;
+	_gcjseq++;
+	_gcjrun = _nr_gcw - 1;
+	pthread_cond_broadcast(&_condgcw);
+	_munlock(&_mgcw);
+
+	_gcw_run(&_gcws[0], job);
+
+	_mlock(&_mgcw);
+	while (_gcjrun)
+		if (pthread_cond_wait(&_condgcwd, &_mgcw))
+			ylassert(0);
+	_munlock(&_mgcw);
+	_gcpar = 1;
+}
+
+/*
+ * Scan grey blocks.
+ * This uses mark stack instead of recursion.
+ * So, very long list doesn't consume C stack.
+ * @deadline : 0 means 'no limit'
+ * @return   : 1 if there is no more grey block. Otherwise 0.
+ */
+static int
+_gc_drain(unsigned long long deadline) {
+	struct _gcw* w0 = &_gcws[0];
+	unsigned int i;
+	_gcdeadline = deadline;
+	_gcstop = 0;
+	if (_nr_gcw > 1
+	    && (_gcfull
+		|| _mbt_nr_used_blk(_m) - _live >= _GCW_PAR_MIN)) {
+		/* distribute grey blocks to workers */
+		_pfq_flush(w0);
+		for (i = 0; ylstk_size(w0->ps); i = (i + 1) % _nr_gcw)
+			ylstk_push(_gcws[i].sd, ylstk_pop(w0->ps));
+		_gcactive = _nr_gcw;
+		_gcw_par_run(_GCJMark);
+		/* collect grey blocks left */
+		for (i = 0; i < _nr_gcw; i++) {
+			while (ylstk_size(_gcws[i].sd))
+				ylstk_push(w0->ps, ylstk_pop(_gcws[i].sd));
+			if (i)
+				while (ylstk_size(_gcws[i].ps))
+					ylstk_push(w0->ps,
+						   ylstk_pop(_gcws[i].ps));
+		}
+	} else
+		_gcw_mark(w0);
+	return !ylstk_size(w0->ps);
+}
+
+/*
+ * Clean atoms deferred by lazy sweep, and put them back to pool.
+ * Their chunks are already aged. (See '_gc_sweep_step')
+ *
+ * Pre-condition
+ *    - _mm is locked!
+ */
+static void
+_gc_sweep_deferred(void) {
+	struct _gcw* w0 = &_gcws[0];
+	yle_t*       e;
+	while (ylstk_size(w0->dfr)) {
+		e = ylstk_pop(w0->dfr);
+		yleclean(e);
+		_mbt_put_old(_m, e);
+		_live--;
+		_gcsfreed++;
+	}
+}
+
+/*
+ * Pre-condition
+ *    - _mm is locked!
+ */
+static void
+_gc_sweep_done(void) {
+	_gc_sweep_deferred();
+	_gcsweep = 0;
+	if (_gcfull) {
+		_live_full = _live;
+		_ext_live_full = _ext_live;
+		_st_nr_full_gc++;
+	}
+	_st_nr_gc++;
+	_st_collected += _gcsfreed;
+	_shrink();
+
+	yllogD("%s GC Triggered (%d\% -> %d\%) :\n"
+	       "%d blocks collected\n"
+	       "%u blocks live, %u blocks in pool\n"
+	       "%u chunks allocated, %u chunks released\n"
+	       "bbs stack size : %d\n",
+	       _gcfull? "Full": "Minor",
+	       _gcsratio, _usage_ratio(),
+	       _gcsfreed, _live, _mbt_sz(_m),
+	       _nr_grow, _nr_shrink,
+	       ylstk_size(_bbs));
+}
+
+/*
+ * Sweep one chunk at cursor - called at allocation.
+ *
+ * Pre-condition
+ *    - _mm is locked!
+ */
+static void
+_gc_sweep_step(void) {
+	struct _gcw*  w0 = &_gcws[0];
+	struct _mbtc* c;
+	unsigned int  fbi, freed;
+
+	ylassert(_gcsweep && _gcsci < _m->nc);
+	c = _m->c[_gcsci];
+	fbi = c->fbi;
+	/*
+	 * Custom atom is cleaned after all chunks are swept - same with
+	 *   '_gc_sweep_rest'. (See '_gc_sweep_done')
+	 */
+	_sweep_chunk(w0, c, 1);
+	/* survivors are promoted */
+	c->wm = c->fbi;
+	freed = c->fbi - fbi;
+	_m->nused -= freed;
+	_live -= freed;
+	_gcsfreed += freed;
+	if (freed)
+		_mbt_lower_lo(_m, _gcsci);
+	if (++_gcsci >= _m->nc)
+		_gc_sweep_done();
+}
+
+/*
+ * Sweep all chunks left at once.
+ *
+ * Pre-condition
+ *    - _mm is locked!
+ */
+static void
+_gc_sweep_rest(void) {
+	unsigned int i, from, used;
+	yle_t*       e;
+
+	/* chunks swept by '_gc_sweep_step' are already aged */
+	_gc_sweep_deferred();
+	used = _mbt_nr_used_blk(_m);
+	from = _gcsci;
+	for (i = 0; i < _nr_gcw; i++)
+		_gcws[i].cnt = 0;
+	if (_nr_gcw > 1
+	    && (_gcfull || (_m->nc - from) * _m->csz >= _GCW_PAR_MIN))
+		_gcw_par_run(_GCJSweep);
+	else
+		_gcw_sweep(&_gcws[0]);
+	for (i = 0; i < _nr_gcw; i++) {
+		while (ylstk_size(_gcws[i].dfr)) {
+			e = ylstk_pop(_gcws[i].dfr);
+			yleclean(e);
+			_mbtc_put(_mbt_chunk_of(_m, e), e);
+		}
+	}
+	/* survivors are promoted */
+	for (i = from; i < _m->nc; i++)
+		_m->c[i]->wm = _m->c[i]->fbi;
+	_mbt_recount(_m);
+	_live -= used - _mbt_nr_used_blk(_m);
+	_gcsfreed += used - _mbt_nr_used_blk(_m);
+	_gc_sweep_done();
+}
+
+void
+ylmp_remember(yle_t* e) {
+	_mlock(&_mm);
+	if (!yleis_remembered(e)) {
+		e->t |= YLERemembered;
+		ylstk_push(_rs, e);
+	}
+	_munlock(&_mm);
+}
+
+void
+ylmp_escape(yle_t* e) {
+	_mlock(&_mm);
+	ylstk_push(_esc, e);
+	_munlock(&_mm);
+}
+
+void
+ylmp_region_end(yletcxt_t* cxt) {
+	if (!ylgcregion() && !_gccompact)
+		return;
+	_mlock(&_mm);
+	if (ylgcregion()
+	    && _gc_enabled
+	    && _GCIdle == _gcphase
+	    && _young() >= _nursery_sz() / _REGION_RATIO) {
+		_gcregion = 1;
+		ylmt_request_safe(1);
+	}
+	/* compaction is done only here. (See '_compact_ready') */
+	if (_gccompact) {
+		if (_gccskip)
+			_gccskip--;
+		else
+			ylmt_request_safe(1);
+	}
+	_munlock(&_mm);
+	ylmt_safepoint(cxt);
+}
+
+/*
+ * Shade young blocks referred by remembered blocks, and clear remembered set.
+ * (All of them become old after GC.)
+ */
+static void
+_gc_mark_remembered(void) {
+	yle_t* e;
+	while (ylstk_size(_rs)) {
+		e = ylstk_pop(_rs);
+		e->t &= ~YLERemembered;
+		if (yleis_atom(e)) {
+			if (ylaif(e)->visit)
+				ylaif(e)->visit(e, &_gcws[0], &_shade_cb);
+		} else if (ylpcar(e)) {
+			_shade(&_gcws[0], ylpcar(e));
+			_shade(&_gcws[0], ylpcdr(e));
+		}
+	}
+}
+
+/*
+ * Old blocks are scanned at full GC. So, remembered set is useless.
+ */
+static void
+_gc_clear_remembered(void) {
+	yle_t* e;
+	while (ylstk_size(_rs)) {
+		e = ylstk_pop(_rs);
+		e->t &= ~YLERemembered;
+	}
+}
+
+static int
+_gc_perthread_mark(void* user, yletcxt_t* cxt) {
+	unsigned int i;
+	if (ylstk_size(cxt->bbs) > _st_bbs_max)
+		_st_bbs_max = ylstk_size(cxt->bbs);
+	for (i = 0; i < ylstk_size(cxt->bbs); i++)
+		_shade(&_gcws[0], cxt->bbs->item[i]);
+	/* tail call requested but not taken yet (See 'yleval_tail') */
+	if (cxt->tle) {
+		_shade(&_gcws[0], cxt->tle);
+		_shade(&_gcws[0], cxt->tla);
+	}
+	ylslu_gcmark(cxt->slut);
+	return 1; /* keep going to the end */
+}
+
+static int
+_gc_perthread_mcache(void* user, yletcxt_t* cxt) {
+	ylmcache_gcmark(cxt);
+	return 1; /* keep going to the end */
+}
+
+static int
+_gc_perthread_release(void* user, yletcxt_t* cxt) {
+	_tlab_release(cxt);
+	return 1; /* keep going to the end */
+}
+
+static void
+_gc_mark_roots(void) {
+	yle_t* e;
+	int    i;
+	_mlock(&_mbbs);
+	if (ylstk_size(_bbs) > _st_bbs_max)
+		_st_bbs_max = ylstk_size(_bbs);
+	/* we should keep memory blocks reachable from base blocks */
+	stack_foreach(_bbs, e, i)
+		_shade(&_gcws[0], e);
+	_munlock(&_mbbs);
+
+	/*
+	 * memory blocks reachable from each thread symbol table
+	 *   should be preserved
+	 */
+	ylmt_walk_locked(NULL, NULL, &_gc_perthread_mark);
+
+	/*
+	 * memory blocks reachable from global symbol should be preserved.
+	 * Old blocks are already marked at minor GC. So, only escaped
+	 *   young blocks are shaded.
+	 */
+	if (_gcfull)
+		ylgsym_gcmark();
+	else
+		stack_foreach(_esc, e, i)
+			_shade(&_gcws[0], e);
+}
+
+/*
+ * Clear GC mark of chunks from cursor.
+ * @return : 1 if all chunks are cleared. Otherwise 0.
  */
-static ylstk_t*         _bbs;   /**< Base-Block-Stack */
+static int
+_gc_clear(unsigned long long deadline) {
+	struct _mbtc* c;
+	unsigned int  i;
+	for (; _gccci < _m->nc; _gccci++) {
+		if (deadline && _now_us() >= deadline)
+			return 0;
+		c = _m->c[_gccci];
+		for (i = c->fbi; i < _m->csz; i++)
+			yleclear_gcmark(c->fbp[i]);
+	}
+	return 1;
+}
 
+static void
+_gc_start(void) {
+	_gcregion = 0;
+	_gcfull = _gcforce || _need_full_gc();
+	if (_gcfull) {
+		_gccci = 0;
+		_gcphase = _GCClear;
+	} else {
+		_gc_mark_remembered();
+		_gc_mark_roots();
+		_gcphase = _GCMark;
+	}
+}
 
-/* condition - used at GC */
-static pthread_cond_t   _condgc = PTHREAD_COND_INITIALIZER;
+/*
+ * Remark, and start lazy sweep.
+ */
+static void
+_gc_finish(void) {
+	/* remark */
+	_gc_mark_remembered();
+	_gc_mark_roots();
+	_gc_drain(0);
+	/* others are all marked. Drop cached expansions of garbage */
+	ylmt_walk_locked(NULL, NULL, &_gc_perthread_mcache);
+	_gc_drain(0);
+	/* escaped blocks are all marked - old - now */
+	ylstk_clean(_esc);
 
-static pthread_mutex_t  _mbbs;
-static pthread_mutex_t  _mm;
+	/* free blocks in buffers should not be swept */
+	ylmt_walk_locked(NULL, NULL, &_gc_perthread_release);
 
-static int              _gc_enabled = 1; /**< 0 means gc is disabled forcely */
+	/*
+	 * Unmarked blocks are still counted as used.
+	 * They are subtracted from '_live' as they are swept.
+	 */
+	_live = _mbt_nr_used_blk(_m);
+	/* external memory of garbage is subtracted as it's swept, too. */
+	_ext_live = _ext;
+	_gcsratio = _usage_ratio();
+	_gcsfreed = 0;
+	_gcsci = 0;
+	_gcsweep = 1;
+	_gcphase = _GCIdle;
+}
 
 /*
- * Memory usage ratio! (percent.)
+ * Is there GC work to do now?
  */
-static inline int
-_usage_ratio(void) { return _mbt_nr_used_blk(_m) * 100 / _m->sz; }
+static int
+_gc_pending(void) {
+	if (_GCIdle == _gcphase)
+		return _gcregion || _need_gc();
+	/*
+	 * GC cycle is in progress.
+	 * Slice is run after evaluation runs at least as long as 'gcpause'.
+	 * But, if too many blocks are allocated during cycle, cycle should be
+	 *   finished as soon as possible.
+	 */
+	return _young() >= 2 * _nursery_sz()
+		|| _now_us() >= _gcslice_end + ylgcpause();
+}
 
-yle_t*
-ylmp_block(void) {
-	yle_t* e;
-	_mlock(&_mm);
-	e = _mbt_get(_m);
-	_munlock(&_mm);
-	if (!e) {
-		/*
-		 * size of _m is constant.
-		 * So, we don't need to lock when read '_m->sz'
-		 */
-		yllogE("Not enough Memory Pool.. Current size is %d\n",
-		       _m->sz);
-		ylassert(0);
-	} else {
-		dbg_mem(e->evid = yleval_id(););
-		/*
-		 * initialize block (make car and cdr be NULL)
-		 * (See comments ylmp_clean_block)
-		 * => This is important!
-		 */
-		ylmp_clean_block(e);
+/*
+ * Run one GC slice.
+ * If 'gcpause' is 0, whole GC cycle is done at once.
+ *
+ * Pre-condition
+ *    - mthread module is locked!
+ *    - _mm is locked!
+ */
+static void
+_gc(void) {
+	unsigned long long start, deadline;
+	start = _now_us();
+	deadline = ylgcpause()? start + ylgcpause(): 0;
+	/* too many blocks are allocated during cycle. Finish it at once */
+	if (_gcforce
+	    || (_GCIdle != _gcphase
+		&& _young() >= 2 * _nursery_sz()))
+		deadline = 0;
+
+	if (_GCIdle == _gcphase) {
+		/* marks of last cycle are needed to sweep */
+		if (_gcsweep)
+			_gc_sweep_rest();
+		_gc_start();
+	}
+
+	if (_GCClear == _gcphase && _gc_clear(deadline)) {
+		_gc_clear_remembered();
+		_gc_mark_roots();
+		_gcphase = _GCMark;
 	}
+
+	if (_GCMark == _gcphase
+	    && (!deadline || _now_us() < deadline)
+	    && _gc_drain(deadline))
+		_gc_finish();
+
+	_gcslice_end = _now_us();
+	_pause_record(_gcslice_end - start);
+}
+
+static inline yle_t*
+_fwd(yle_t* e) {
+	if (e && !yleis_atom(e) && (e->t & YLEMoved))
+		return ylpcar(e);
 	return e;
 }
 
-void
-ylmp_add_bb(yle_t* e) {
-	_mlock(&_mbbs);
-	ylstk_push(_bbs, e);
-	_munlock(&_mbbs);
+/*
+ * Pin pairs reachable from 'e'.
+ */
+static void
+_pin(yle_t* e) {
+	ylstk_t* s = _gcws[0].ps;
+	ylstk_push(s, e);
+	while (ylstk_size(s)) {
+		e = ylstk_pop(s);
+		if (yleis_atom(e) || (e->t & YLEPinned))
+			continue;
+		e->t |= YLEPinned;
+		if (ylpcar(e)) {
+			ylstk_push(s, ylpcar(e));
+			ylstk_push(s, ylpcdr(e));
+		}
+	}
+}
+
+static int
+_pin_cb(void* user, yle_t* e) {
+	if (!yleis_atom(e))
+		e->t |= YLEPinned;
+	return 1;
+}
+
+static int
+_pin_perthread(void* user, yletcxt_t* cxt) {
+	unsigned int i;
+	for (i = 0; i < ylstk_size(cxt->bbs); i++)
+		_pin(cxt->bbs->item[i]);
+	return 1; /* keep going to the end */
+}
+
+static int
+_relocate_perthread(void* user, yletcxt_t* cxt) {
+	ylslu_relocate(cxt->slut, &_fwd);
+	/*
+	 * Nobody is evaluating. So, tail call left is the one abandoned by
+	 *   error. It's not pinned.
+	 */
+	cxt->tle = cxt->tla = NULL;
+	/* expansions are cheap to rebuild */
+	ylmcache_clear(cxt);
+	return 1; /* keep going to the end */
+}
+
+static int
+_evaluating(void* user, yletcxt_t* cxt) {
+	if (ylstk_size(cxt->evalstk)) {
+		*(int*)user = 1;
+		return 0; /* stop */
+	}
+	return 1;
+}
+
+static int
+_cmp_chunk_used(const void* a, const void* b) {
+	unsigned int fa = (*(struct _mbtc**)a)->fbi;
+	unsigned int fb = (*(struct _mbtc**)b)->fbi;
+	/* more free blocks means less used */
+	return fa > fb? -1: fa < fb? 1: 0;
 }
 
 /*
- * This modifies stack directly!
+ * Pick sparse pair chunks as source of moving.
+ * Live pairs of sources should fit into free blocks of other pair chunks.
+ * @cs     : [out] pair chunks. Sources first, and targets in order of
+ *           density.
+ * @return : number of sources.
  */
-void
-ylmp_rm_bb(yle_t* e) {
-	register int i;
-	_mlock(&_mbbs);
-	i = ylstk_size(_bbs)-1; /* top */
-	for (;i >= 0; i --) {
-		if (_bbs->item[i] == (void*)e) {
-			/* we found! */
-			memmove(&_bbs->item[i], &_bbs->item[i+1],
-				sizeof(_bbs->item[i])*(ylstk_size(_bbs)-i-1));
-			_bbs->sz--;
-			_munlock(&_mbbs);
-			return; /* done! */
+static unsigned int
+_compact_pick(struct _mbtc** cs, unsigned int* ncs) {
+	unsigned int i, n, nsrc, used, moving, free;
+	struct _mbtc* c;
+	n = free = 0;
+	for (i = 0; i < _m->nc; i++) {
+		c = _m->c[i];
+		/* empty chunk will be released. Skip it. */
+		if (YLBKPair != c->kind || c->fbi >= _m->csz)
+			continue;
+		cs[n++] = c;
+		free += c->fbi;
+	}
+	*ncs = n;
+	qsort(cs, n, sizeof(*cs), &_cmp_chunk_used);
+	moving = 0;
+	for (nsrc = 0; nsrc < n; nsrc++) {
+		used = _m->csz - cs[nsrc]->fbi;
+		free -= cs[nsrc]->fbi;
+		/* dense chunk is not worth moving */
+		if (used > _m->csz / 2 || moving + used > free)
+			break;
+		moving += used;
+	}
+	return nsrc;
+}
+
+/*
+ * Full GC at once. Only live blocks are in use after this.
+ *
+ * Pre-condition
+ *    - mthread module is locked!
+ *    - _mm is locked!
+ */
+static void
+_gc_full(void) {
+	_gcforce = 1;
+	if (_GCIdle != _gcphase)
+		_gc(); /* finish cycle in progress */
+	_gc();
+	_gc_sweep_rest();
+	_gcforce = 0;
+}
+
+/*
+ * Pre-condition
+ *    - mthread module is locked!
+ *    - _mm is locked!
+ *    - No thread is evaluating expression.
+ */
+static void
+_gc_compact(void) {
+	struct _mbtc**     cs;
+	struct _mbtc*      c;
+	unsigned int       ncs, nsrc, ti, ci, i, moved;
+	unsigned long long start;
+	yle_t             *e, *n;
+
+	_gc_full();
+	ylassert(!ylstk_size(_rs) && !ylstk_size(_esc));
+
+	start = _now_us();
+	cs = ylmalloc(sizeof(*cs) * _m->nc);
+	if (!cs)
+		return; /* OOM. Skip compaction */
+
+	/* pin */
+	for (i = 0; i < ylstk_size(_bbs); i++)
+		_pin(_bbs->item[i]);
+	ylmt_walk_locked(NULL, NULL, &_pin_perthread);
+	_mbt_foreach_used(_m, ci, i, e)
+		if (yleis_atom(e) && ylaif(e)->visit)
+			ylaif(e)->visit(e, NULL, &_pin_cb);
+
+	/* move */
+	moved = 0;
+	nsrc = _compact_pick(cs, &ncs);
+	ti = ncs;
+	for (ci = 0; ci < nsrc; ci++) {
+		c = cs[ci];
+		for (i = c->fbi; i < _m->csz; i++) {
+			e = c->fbp[i];
+			if (e->t & YLEPinned)
+				continue;
+			/* take from the densest target */
+			while (ti > nsrc && !cs[ti - 1]->fbi)
+				ti--;
+			if (ti <= nsrc)
+				break;
+			n = cs[ti - 1]->fbp[--cs[ti - 1]->fbi];
+			*n = *e;
+			e->t |= YLEMoved;
+			ylpcar(e) = n;
+			moved++;
 		}
 	}
-	_munlock(&_mbbs);
-	if (i<0)
-		yllogW("WARN!! Try to remove unregistered base block! : %p\n",
-		       e);
+
+	/* fix up references */
+	_mbt_foreach_used(_m, ci, i, e) {
+		if (yleis_atom(e) || (e->t & YLEMoved) || !ylpcar(e))
+			continue;
+		ylpcar(e) = _fwd(ylpcar(e));
+		ylpcdr(e) = _fwd(ylpcdr(e));
+	}
+	ylgsym_relocate(&_fwd);
+	ylmt_walk_locked(NULL, NULL, &_relocate_perthread);
+
+	/* release moved blocks, and unpin */
+	for (ci = 0; ci < nsrc; ci++) {
+		c = cs[ci];
+		for (i = c->fbi; i < _m->csz; i++) {
+			e = c->fbp[i];
+			if (e->t & YLEMoved) {
+				ylmp_clean_block(e);
+				_mbtc_put(c, e);
+			}
+		}
+	}
+	_mbt_foreach_used(_m, ci, i, e)
+		e->t &= ~YLEPinned;
+	/* all blocks are old */
+	for (ci = 0; ci < _m->nc; ci++)
+		_m->c[ci]->wm = _m->c[ci]->fbi;
+	_mbt_recount(_m);
+	ylfree(cs);
+
+	_st_nr_compact++;
+	_st_moved += moved;
+	_shrink();
+	_gcslice_end = _now_us();
+	_pause_record(_gcslice_end - start);
+	yllogD("Compaction : %u pairs moved from %u chunks\n", moved, nsrc);
+}
+
+/*
+ * Is compaction requested, and can it be done now?
+ *
+ * Pre-condition
+ *    - mthread module is locked!
+ *    - _mm is locked!
+ */
+static int
+_compact_ready(void) {
+	int beval = 0;
+	if (!_gccompact || !_gc_enabled)
+		return 0;
+	ylmt_walk_locked(NULL, &beval, &_evaluating);
+	return !beval;
+}
+
+/*
+ * Compaction requested cannot be done now.
+ * Try that isn't asked by region end - ex. slice of GC - is not counted.
+ *
+ * Pre-condition
+ *    - _mm is locked!
+ */
+static void
+_compact_backoff(void) {
+	if (_gccskip)
+		return;
+	if (++_gcctry >= _COMPACT_MAX_TRY) {
+		yllogD("Compaction is withdrawn : thread is evaluating\n");
+		_gccompact = 0;
+		_gcctry = 0;
+	} else
+		_gccskip = (1 << _gcctry) - 1;
 }
 
 void
-ylmp_clean_bb(void) {
-	_mlock(&_mbbs);
-	ylstk_clean(_bbs);
-	_munlock(&_mbbs);
+ylgc_compact(void) {
+	_mlock(&_mm);
+	_gccompact = 1;
+	_gcctry = _gccskip = 0;
+	_munlock(&_mm);
+}
+
+/*
+ * Heap census
+ * -----------
+ * Blocks in use are counted by type after full GC. And retained size of
+ *   each symbol in symbol tables is measured by walking blocks reachable
+ *   from its value.
+ * Census is taken while all threads are in safe state. 'YLEMark' is used
+ *   as 'visited' mark while walking, and cleared before walking next one.
+ * (See 'ylgc_census')
+ */
+static ylcensus_t*      _census; /**< census requested by thread */
+
+struct _census_walk {
+	ylcensus_t*    c;
+	ylstk_t*       s;   /**< blocks to visit */
+	ylstk_t*       vs;  /**< blocks visited */
+	int            local;
+};
+
+static inline unsigned long
+_payload(const yle_t* e) {
+	if (yleis_atom(e) && ylaif(e)->size)
+		return (*ylaif(e)->size)(e);
+	return 0;
 }
 
-/* =========================
- * GC !!! (START)
- * =========================*/
 static void
-_clean_block(yle_t* e) {
-	ylassert(e != ylnil() && e != ylt() && e != ylq());
-	yleclean(e);
-	_mbt_put(_m, e);
+_census_count(ylcensus_t* c, const char* name, unsigned long bytes) {
+	unsigned int i;
+	for (i = 0; i < c->nty; i++)
+		if (!strcmp(c->ty[i].name, name))
+			break;
+	if (i == c->nty) {
+		/* last slot is kept for "custom" */
+		if (c->nty >= YLCENSUS_TYPE_MAX - 1 && strcmp(name, "custom")) {
+			_census_count(c, "custom", bytes);
+			return;
+		}
+		strncpy(c->ty[i].name, name, YLCENSUS_NAME_MAX - 1);
+		c->nty++;
+	}
+	c->ty[i].cnt++;
+	c->ty[i].bytes += bytes;
+}
+
+static int
+_census_push_cb(void* user, yle_t* e) {
+	ylstk_push((ylstk_t*)user, e);
+	return 1;
 }
 
+static int
+_census_sym_cb(void* user, const char* sym, unsigned int symsz, yle_t* e) {
+	struct _census_walk* w = user;
+	ylcensus_t*          c = w->c;
+	unsigned int         cnt = 0, i;
+	unsigned long        bytes = 0;
+
+	ylstk_push(w->s, e);
+	while (ylstk_size(w->s)) {
+		e = ylstk_pop(w->s);
+		/* immediate number is not block */
+		if (yleis_imm(e) || yleis_mark(e))
+			continue;
+		yleset_mark(e);
+		ylstk_push(w->vs, e);
+		cnt++;
+		bytes += sizeof(yle_t) + _payload(e);
+		if (yleis_atom(e)) {
+			if (ylaif(e)->visit)
+				ylaif(e)->visit(e, w->s, &_census_push_cb);
+		} else if (ylpcar(e)) {
+			ylstk_push(w->s, ylpcar(e));
+			ylstk_push(w->s, ylpcdr(e));
+		}
+	}
+	while (ylstk_size(w->vs))
+		yleclear_mark((yle_t*)ylstk_pop(w->vs));
 
-_DEF_VISIT_FUNC(static, _gcmark, ,!yleis_gcmark(e), yleset_gcmark(e))
+	/* insert into top list sorted by bytes */
+	for (i = c->ntop; i > 0 && c->top[i - 1].bytes < bytes; i--)
+		if (i < YLCENSUS_TOP_MAX)
+			c->top[i] = c->top[i - 1];
+	if (i >= YLCENSUS_TOP_MAX)
+		return 1;
+	if (c->ntop < YLCENSUS_TOP_MAX)
+		c->ntop++;
+	if (symsz > YLCENSUS_SYM_MAX - 1)
+		symsz = YLCENSUS_SYM_MAX - 1;
+	memcpy(c->top[i].sym, sym, symsz);
+	c->top[i].sym[symsz] = 0;
+	c->top[i].local = w->local;
+	c->top[i].cnt = cnt;
+	c->top[i].bytes = bytes;
+	return 1; /* keep going */
+}
 
 static int
-_gc_perthread_mark(void* user, yletcxt_t* cxt) {
-	ylslu_gcmark(cxt->slut);
+_census_perthread(void* user, yletcxt_t* cxt) {
+	ylslu_walk(cxt->slut, user, &_census_sym_cb);
 	return 1; /* keep going to the end */
 }
 
 /*
  * Pre-condition
- *    - mthread module is locked!
+ *    - _mm is locked!
+ *    - All threads are in safe state.
  */
 static void
-_gc(void) {
-	unsigned int  cnt __attribute__ ((unused));
-	unsigned int  ratio_sv __attribute__ ((unused));
-	int           i;
-	yle_t*        e;
-
-	/* clear all GC mark */
-	_mbt_foreach_used(_m, i, e)
-		yleclear_gcmark(e);
+_census_take(ylcensus_t* c) {
+	struct _census_walk w;
+	unsigned int        ci, i;
+	yle_t*              e;
 
-	_mlock(&_mbbs);
-	/* we should keep memory blocks reachable from base blocks */
-	stack_foreach(_bbs, e, i)
-		_gcmark(NULL, e);
+	if (_gc_enabled)
+		_gc_full();
+	memset(c, 0, sizeof(*c));
+	_mbt_foreach_used(_m, ci, i, e) {
+		if (yleis_atom(e))
+			_census_count(c,
+				      ylaif(e)->name? ylaif(e)->name: "custom",
+				      _payload(e));
+		else if (ylpcar(e))
+			/* pair whose car is NULL, is clean block in TLAB */
+			_census_count(c, "pair", 0);
+	}
 
-	_munlock(&_mbbs);
+	w.c = c;
+	w.s = ylstk_create(_CHUNKSZ, NULL);
+	w.vs = ylstk_create(_CHUNKSZ, NULL);
+	w.local = 0;
+	ylgsym_walk(&w, &_census_sym_cb);
+	w.local = 1;
+	ylmt_walk_locked(NULL, &w, &_census_perthread);
+	ylstk_destroy(w.s);
+	ylstk_destroy(w.vs);
+}
 
-	/*
-	 * memory blocks reachable from each thread symbol table
-	 *   should be preserved
-	 */
-	ylmt_walk_locked(NULL, NULL, &_gc_perthread_mark);
+void
+ylmp_census(yletcxt_t* cxt, ylcensus_t* c) {
+	int bdone;
+	_mlock(&_mm);
+	/* one census at a time */
+	while (_census) {
+		_munlock(&_mm);
+		ylmt_safepoint_slow(cxt);
+		_mlock(&_mm);
+	}
+	_census = c;
+	ylmt_request_safe(1);
+	_munlock(&_mm);
+	/* census is taken when all threads come to safe point */
+	do {
+		ylmt_safepoint_slow(cxt);
+		_mlock(&_mm);
+		bdone = _census != c;
+		_munlock(&_mm);
+	} while (!bdone);
+}
 
-	/* memory blocks reachable from global symbol should be preserved */
-	ylgsym_gcmark();
+void
+ylgc_census(ylcensus_t* c) {
+	_mlock(&_mm);
+	_census_take(c);
+	_munlock(&_mm);
+}
 
-	ratio_sv = _usage_ratio();
-	cnt = 0;
-	/* Collect unmarked memory blocks */
-	_mbt_foreach_used(_m, i, e)
-		if (!yleis_gcmark(e)) {
-			cnt++;
-			_clean_block(e);
-		}
+int
+ylgc_census_dump(const ylcensus_t* c, const char* fpath) {
+	FILE*        f;
+	unsigned int i;
 
-	yllogD("GC Triggered (%d\% -> %d\%) :\n"
-	       "%d blocks collected\n"
-	       "bbs stack size : %d\n",
-	       ratio_sv, _usage_ratio(),
-	       cnt, ylstk_size(_bbs));
+	f = fopen(fpath, "w");
+	if (!f)
+		return -1;
+	for (i = 0; i < c->nty; i++)
+		fprintf(f, "type %s %u %lu\n",
+			c->ty[i].name, c->ty[i].cnt, c->ty[i].bytes);
+	for (i = 0; i < c->ntop; i++)
+		fprintf(f, "sym %c %s %u %lu\n",
+			c->top[i].local? 'l': 'g',
+			c->top[i].sym, c->top[i].cnt, c->top[i].bytes);
+	return fclose(f)? -1: 0;
 }
 
 static void
@@ -216,7 +2111,9 @@ _mt_listener_post_add(const yletcxt_t* cxt) {
 
 static void
 _mt_listener_pre_rm(const yletcxt_t* cxt) {
-	/* nothing to do */
+	_mlock(&_mm);
+	_tlab_release((yletcxt_t*)cxt);
+	_munlock(&_mm);
 }
 
 static void
@@ -229,7 +2126,12 @@ _mt_listener_thd_safe(const yletcxt_t* cxt, pthread_mutex_t* mtx) {
 	/* try GC */
 	int   btry;
 	_mlock(&_mm);
-	btry = (_usage_ratio() >= ylgctp());
+	/*
+	 * Waiting thread is woken up only by 'all_safe'.
+	 * So, other threads should be requested to come to safe point too.
+	 */
+	btry = _census || (_gc_enabled && _gc_pending());
+	ylmt_request_safe(btry);
 	_munlock(&_mm);
 	if (btry) {
 		dbg_mutex(yllogD("+CondWait : TryGC ..."););
@@ -242,18 +2144,38 @@ _mt_listener_thd_safe(const yletcxt_t* cxt, pthread_mutex_t* mtx) {
 static void
 _mt_listener_all_safe(pthread_mutex_t* mtx) {
 	_mlock(&_mm);
-	if (_usage_ratio() >= ylgctp()) {
+	if (_compact_ready()) {
+		_gccompact = 0;
+		_gcctry = _gccskip = 0;
+		_gc_compact();
+	} else if (_gccompact)
+		_compact_backoff();
+	if (_census) {
+		_census_take(_census);
+		_census = NULL;
+	}
+	if (_gc_pending()) {
 		if (_gc_enabled)
 			_gc();
 		else
 			yllogW(
 "Memory is running out! But GC is disabled!!!\n"
 			       );
+		/* next slice of incremental GC is requested later. */
+		ylmt_request_safe(_gc_enabled && _gc_pending());
 		_munlock(&_mm);
 		dbg_mutex(yllogD("+CondBroadcast : GC done\n"););
 		pthread_cond_broadcast(&_condgc);
 	} else {
+		ylmt_request_safe(0);
 		_munlock(&_mm);
+		/*
+		 * GC may not be pending anymore even if there are threads
+		 *   waiting for it at 'thd_safe'.
+		 * (ex. blocks are freed by lazy sweep, or GC is disabled.)
+		 * Those should be woken up too.
+		 */
+		pthread_cond_broadcast(&_condgc);
 	}
 }
 
@@ -276,58 +2198,172 @@ ylmp_gc_enable(int v) {
 	_mlock (&_mm);
 	sv = _gc_enabled;
 	_gc_enabled = v;
+	_request_gc();
 	_munlock(&_mm);
 	return sv;
 }
 
+static void
+_gcw_destroy(void) {
+	unsigned int i;
+	if (!_gcws)
+		return;
+	/* stop GC-only threads */
+	_mlock(&_mgcw);
+	_gcjob = _GCJExit;
+	_gcjseq++;
+	pthread_cond_broadcast(&_condgcw);
+	_munlock(&_mgcw);
+	for (i = 1; i < _nr_gcw; i++)
+		pthread_join(_gcws[i].thd, NULL);
+
+	for (i = 0; i < _nr_gcw; i++) {
+		ylstk_destroy(_gcws[i].ps);
+		ylstk_destroy(_gcws[i].sd);
+		ylstk_destroy(_gcws[i].dfr);
+		pthread_mutex_destroy(&_gcws[i].msd);
+	}
+	ylfree(_gcws);
+	_gcws = NULL;
+	pthread_mutex_destroy(&_mgcw);
+}
+
+/*
+ * @return : <0 if fails (OOM)
+ */
+static int
+_gcw_create(void) {
+	unsigned int i, n;
+	long         ncpu;
+
+	n = ylgcthread();
+	if (!n) {
+		ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+		n = ncpu > 0? (unsigned int)ncpu: 1;
+	}
+	if (n > _GCW_MAX)
+		n = _GCW_MAX;
+
+	_gcws = ylmalloc(sizeof(*_gcws) * n);
+	if (!_gcws)
+		return -1;
+	memset(_gcws, 0, sizeof(*_gcws) * n);
+	pthread_mutex_init(&_mgcw, ylmutexattr());
+	_gcjseq = 0;
+	_gcpar = 1;
+	for (i = 0; i < n; i++) {
+		_gcws[i].id = i;
+		_gcws[i].ps = ylstk_create(_CHUNKSZ, NULL);
+		_gcws[i].sd = ylstk_create(_CHUNKSZ, NULL);
+		_gcws[i].dfr = ylstk_create(0, NULL);
+		pthread_mutex_init(&_gcws[i].msd, ylmutexattr());
+	}
+	/* worker 0 is thread running GC */
+	_nr_gcw = 1;
+	for (i = 1; i < n; i++) {
+		if (pthread_create(&_gcws[i].thd, NULL,
+				   &_gcw_main, &_gcws[i])) {
+			yllogW("Fail to create GC thread! %u threads are used\n",
+			       _nr_gcw);
+			break;
+		}
+		_nr_gcw++;
+	}
+	/* workers failed to start, are not used */
+	for (; i < n; i++) {
+		ylstk_destroy(_gcws[i].ps);
+		ylstk_destroy(_gcws[i].sd);
+		ylstk_destroy(_gcws[i].dfr);
+		pthread_mutex_destroy(&_gcws[i].msd);
+	}
+	return 0;
+}
+
 static ylerr_t
 _mod_init(void) {
 	/* init memory pool */
-	register int i;
-	yle_t*       e;
-
 	/* initialise pointers requiring mem. alloc. */
 	_bbs = NULL;
 
 	pthread_mutex_init(&_mm, ylmutexattr());
 	pthread_mutex_init(&_mbbs, ylmutexattr());
+	if (pthread_key_create(&_cxtkey, NULL))
+		goto bail_key;
 
 	/* allocated memory pool */
-	_m = _mbt_create(ylmpsz());
+	_m = _mbt_create(_CHUNKSZ, 1);
 	if (!_m)
 		goto bail_m;
-	_bbs = ylstk_create(_m->sz/2, NULL);
+	_live = _live_full = _nr_grow = _nr_shrink = 0;
+	_gcregion = 0;
+	_bbs = ylstk_create(_CHUNKSZ/2, NULL);
 	if (!_bbs)
 		goto bail_bbs;
-
-	_mbt_foreach(_m, i, e)
-		ylmp_clean_block(e);
+	_rs = ylstk_create(_CHUNKSZ/2, NULL);
+	if (!_rs)
+		goto bail_rs;
+	_esc = ylstk_create(_CHUNKSZ/2, NULL);
+	if (!_esc)
+		goto bail_esc;
+	if (0 > _gcw_create())
+		goto bail_gcw;
+	_fin_create();
+	_gcphase = _GCIdle;
+	_gcsweep = 0;
+	_gcslice_end = 0;
+	_nr_pause = _max_pause = _sum_pause = 0;
+	memset(_phist, 0, sizeof(_phist));
+	_st_nr_gc = _st_nr_full_gc = _st_collected = _st_alloc = 0;
+	_st_peak = _st_bbs_max = 0;
+	_st_ext_peak = 0;
+	_st_nr_compact = 0;
+	_st_moved = 0;
+	_gccompact = _gcforce = 0;
+	_gcctry = _gccskip = 0;
+	_census = NULL;
+	_st_t0 = _now_us();
 
 	/* register to mt module to support Muti-Threading */
 	ylmt_register_listener(&_mtlsnr);
 
 	return YLOk;
 
+ bail_gcw:
+	ylstk_destroy(_esc);
+ bail_esc:
+	ylstk_destroy(_rs);
+ bail_rs:
+	ylstk_destroy(_bbs);
  bail_bbs:
 	_mbt_destroy(_m);
  bail_m:
+	pthread_key_delete(_cxtkey);
+ bail_key:
 	return YLErr_out_of_memory;
 }
 
 static ylerr_t
 _mod_exit(void) {
-	int    i;
-	yle_t* e;
+	unsigned int ci, i;
+	yle_t*       e;
+	/* atoms queued are cleaned before finalizer exits */
+	_fin_destroy();
 	_mlock(&_mm);
 	/* Free all elements */
-	_mbt_foreach_used(_m, i, e)
+	_mbt_foreach_used(_m, ci, i, e)
 		yleclean(e);
 
 	if (_bbs)
 		ylstk_destroy(_bbs);
+	if (_rs)
+		ylstk_destroy(_rs);
+	if (_esc)
+		ylstk_destroy(_esc);
+	_gcw_destroy();
 
 	_mbt_destroy(_m);
 
+	pthread_key_delete(_cxtkey);
 	pthread_mutex_destroy(&_mbbs);
 	_munlock(&_mm);
 	pthread_mutex_destroy(&_mm);
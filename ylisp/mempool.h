@@ -38,6 +38,30 @@ ylmp_deinit(void);
 extern int
 ylmp_gc_enable(int v);
 
+/*
+ * Mark block as reachable during GC.
+ * Blocks referred by given block, are marked by GC later.
+ * (So, this doesn't do recursive marking.)
+ * This is used by modules that have GC roots. (ex. symbol lookup table)
+ */
+extern void
+ylmp_gcmark(yle_t* e);
+
+/*
+ * Blocks are allocated from thread local allocation buffer of 'cxt',
+ *   and base blocks are added to stack of 'cxt', in this thread.
+ * This should be called at the beginning of thread evaluating 'cxt'.
+ */
+extern void
+ylmp_bind_cxt(yletcxt_t* cxt);
+
+/*
+ * Take heap census while evaluating 'cxt'.
+ * This waits until all threads come to safe point. (See 'ylgc_census')
+ */
+extern void
+ylmp_census(yletcxt_t* cxt, ylcensus_t* c);
+
 /*****************************************
  * Multi-Thread
  *****************************************/
@@ -83,9 +107,10 @@ static inline void
 ylmp_clean_block(yle_t* e) {
 	/*
 	 * Clean-block's value is like this.!
+	 * (GC bits are also cleared - set directly.)
 	 */
-	yleset_type(e, YLEPair);
-	ylestype(e) = 0; /* set to default */
+	e->t = YLEPair;
+	yleset_stype(e, 0); /* set to default */
 	dbg_mt( ylanfunc(e).f = (void*)0xdeaddead; );
 	ylpcar(e) = ylpcdr(e) = NULL;
 }
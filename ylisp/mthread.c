@@ -68,17 +68,38 @@ struct _pres {
 
 static pthread_mutex_t  _m;     /**< lock for thread management */
 
+static unsigned int     _nr_cxt;  /**< number of evaluation threads */
+static unsigned int     _nr_safe; /**< number of threads in safe state */
+
+volatile int            ylg_mt_spreq = 0;
+
 static YLLIST_DECL_HEAD(_lsnl); /* constructor function list */
 static YLLIST_DECL_HEAD(_cxtl); /* destructor function list */
 
 
+/*
+ * 'ETST_SAFE' is changed only by these, in '_m' lock.
+ * So, checking all-safe state is O(1).
+ */
+static inline void
+_set_safe(yletcxt_t* cxt) {
+	if (!etst_isset(cxt, ETST_SAFE)) {
+		etst_set(cxt, ETST_SAFE);
+		_nr_safe++;
+	}
+}
+
+static inline void
+_clear_safe(yletcxt_t* cxt) {
+	if (etst_isset(cxt, ETST_SAFE)) {
+		etst_clear(cxt, ETST_SAFE);
+		_nr_safe--;
+	}
+}
+
 static inline int
-_etst_is_all(unsigned int state) {
-    _walk_ethreads(
-		   if (!etst_isset(w, state))
-			   return 0;
-		   );
-    return 1;
+_is_all_safe(void) {
+	return _nr_safe == _nr_cxt;
 }
 
 /*===================================================================
@@ -105,6 +126,9 @@ ylmt_add(yletcxt_t* cxt) {
 	_mlock(&_m);
 	_walk_listeners(pre_add, (cxt));
 	yllist_add_last(&_cxtl, &cxt->lk);
+	_nr_cxt++;
+	if (etst_isset(cxt, ETST_SAFE))
+		_nr_safe++;
 	_walk_listeners(post_add, (cxt));
 	_munlock(&_m);
 }
@@ -113,7 +137,9 @@ void
 ylmt_rm(yletcxt_t* cxt) {
 	_mlock(&_m);
 	_walk_listeners(pre_rm, (cxt));
+	_clear_safe(cxt);
 	yllist_del(&cxt->lk);
+	_nr_cxt--;
 	_walk_listeners(post_rm, (cxt));
 
 	/*
@@ -125,7 +151,7 @@ ylmt_rm(yletcxt_t* cxt) {
 	 *
 	 * See 'ylmt_notify_safe()' for more related comments.
 	 */
-	if (_etst_is_all(ETST_SAFE))
+	if (_is_all_safe())
 		_walk_listeners(all_safe, (&_m));
 
 	_munlock(&_m);
@@ -189,7 +215,7 @@ int
 ylmt_is_safe(yletcxt_t* cxt) {
 	int ret;
 	_mlock(&_m);
-	ret = _etst_is_all(ETST_SAFE);
+	ret = _is_all_safe();
 	_munlock(&_m);
 	not_used(cxt);
 	return ret;
@@ -200,18 +226,11 @@ _handle_etsignal(yletcxt_t* cxt) {
 }
 
 /*
- * This can be performance bottleneck!
- * Be careful!
- *
- * !!! Further Thought !!!
- *    We may use 'mark count' for ETST_SAFE,
- *      to reduce one-list-search for '_etst_is_all'
- *    So, 'mark_count' can make complexity of 'ylmt_notify_safe()'
- *      from O(n) to O(1)!.
- *
- *    If needed, consider it!
- *    But, most cases, Simple is Better!!
- *    Keep simple as long as possible!
+ * This locks '_m'. So, this should not be called at every evaluation step.
+ * Evaluation step uses 'ylmt_safepoint' - this is called only if safe point
+ *   is requested.
+ * Number of threads in safe state is counted. So, checking all-safe state
+ *   is O(1).
  */
 void
 ylmt_notify_safe(yletcxt_t* cxt) {
@@ -231,15 +250,15 @@ ylmt_notify_safe(yletcxt_t* cxt) {
 	 * We don't need to use 'cxt->m' lock to mark 'ETST_SAFE'.
 	 * 'ETST_SAFE' is used only in '_m' lock!
 	 */
-	etst_set(cxt, ETST_SAFE);
-	if (_etst_is_all(ETST_SAFE))
+	_set_safe(cxt);
+	if (_is_all_safe())
 		_walk_listeners(all_safe, (&_m));
 	else
 		_walk_listeners(thd_safe, (cxt, &_m));
 
 	/* Handle special signal! */
 	if (etsig_isset(cxt, ETSIG_KILL)) {
-		etst_clear(cxt, ETST_SAFE);
+		_clear_safe(cxt);
 		_munlock(&_m);
 		ylinterpret_undefined (YLErr_killed);
 	} else
@@ -250,10 +269,16 @@ ylmt_notify_safe(yletcxt_t* cxt) {
 void
 ylmt_notify_unsafe(yletcxt_t* cxt) {
 	_mlock(&_m);
-	etst_clear(cxt, ETST_SAFE);
+	_clear_safe(cxt);
 	_munlock(&_m);
 }
 
+void
+ylmt_safepoint_slow(yletcxt_t* cxt) {
+	ylmt_notify_safe(cxt);
+	ylmt_notify_unsafe(cxt);
+}
+
 static inline void
 _kill(yletcxt_t* cxt) {
 	/*
@@ -319,6 +344,8 @@ ylmt_walk_locked(yletcxt_t* cxt, void* user,
 static ylerr_t
 _mod_init(void) {
 	pthread_mutex_init(&_m, ylmutexattr());
+	_nr_cxt = _nr_safe = 0;
+	ylg_mt_spreq = 0;
 	return YLOk;
 }
 
@@ -105,6 +105,37 @@ ylmt_register_listener(const ylmtlsn_t*);
 extern int
 ylmt_is_safe(yletcxt_t* cxt);
 
+/*
+ * Safe point request.
+ * Evaluation thread checks this at safe point without lock.
+ * Thread enters safe state - listeners are called - only if safe point is
+ *   requested, or thread has signal.
+ */
+extern volatile int ylg_mt_spreq;
+
+/*
+ * Request(1) / withdraw(0) safe point.
+ * (ex. memory pool requests safe point when GC is pending.)
+ * This doesn't lock. So, this can be used inside listeners.
+ */
+#define ylmt_request_safe(v) do { ylg_mt_spreq = (v); } while (0)
+
+/*
+ * Enter safe state and leave it at once.
+ */
+extern void
+ylmt_safepoint_slow(yletcxt_t* cxt);
+
+/*
+ * Safe point of evaluation thread.
+ * Fast path is just checking flags.
+ */
+#define ylmt_safepoint(cxt)						\
+	do {								\
+		if (ylg_mt_spreq || (cxt)->sig)				\
+			ylmt_safepoint_slow(cxt);			\
+	} while (0)
+
 /*
  * Kill evaluation thread!
  * Mechanism.
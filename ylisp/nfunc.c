@@ -60,7 +60,7 @@ YLDEFNF(quote, 1, 1) {
 } YLENDNF(quote)
 
 YLDEFNF(apply, 1, 9999) {
-	return ylapply(cxt, ylcar(e), ylcdr(e), a);
+	return ylapply_tail(cxt, ylcar(e), ylcdr(e), a);
 } YLENDNF(apply)
 
 /* eq [car [e]; EQ] -> [eval [cadr [e]; a] = eval [caddr [e]; a]] */
@@ -80,7 +80,7 @@ YLDEFNF(set, 2, 3) {
 				     ylcar(e),
 				     ylcadr(e),
 				     a,
-				     ylasym(ylcaddr(e)).sym, /* desc */
+				     ylasymstr(ylcaddr(e)), /* desc */
 				     YLASym_def);
 		else
 			ylnfinterp_fail(YLErr_func_invalid_param,
@@ -97,7 +97,7 @@ YLDEFNF(tset, 2, 3) {
 				      ylcar(e),
 				      ylcadr(e),
 				      a,
-				      ylasym(ylcaddr(e)).sym, /* desc */
+				      ylasymstr(ylcaddr(e)), /* desc */
 				      YLASym_def);
 		else
 			ylnfinterp_fail(YLErr_func_invalid_param,
@@ -118,7 +118,7 @@ YLDEFNF(f_mset, 2, 3) {
 				     ylcar(e),
 				     ylcadr(e),
 				     a,
-				     ylasym(ylcaddr(e)).sym,
+				     ylasymstr(ylcaddr(e)),
 				     YLASym_mac);
 		else
 			ylnfinterp_fail(YLErr_func_invalid_param,
@@ -139,7 +139,7 @@ YLDEFNF(f_tmset, 2, 3) {
 				      ylcar(e),
 				      ylcadr(e),
 				      a,
-				      ylasym(ylcaddr(e)).sym,
+				      ylasymstr(ylcaddr(e)),
 				      YLASym_mac);
 		else
 			ylnfinterp_fail(YLErr_func_invalid_param,
@@ -155,7 +155,7 @@ YLDEFNF(f_tmset, 2, 3) {
 
 YLDEFNF(unset, 1, 1) {
 	ylnfcheck_parameter(ylais_type(ylcar(e), ylaif_sym()));
-	if (0 <= ylgsym_delete(ylasym(ylcar(e)).sym))
+	if (0 <= ylgsym_delete(ylasymstr(ylcar(e))))
 		return ylt();
 	else
 		return ylnil();
@@ -163,7 +163,7 @@ YLDEFNF(unset, 1, 1) {
 
 YLDEFNF(tunset, 1, 1) {
 	ylnfcheck_parameter(ylais_type(ylcar(e), ylaif_sym()));
-	if (0 <= ylslu_delete(cxt->slut, ylasym(ylcar(e)).sym))
+	if (0 <= ylslu_delete(cxt->slut, ylasymstr(ylcar(e))))
 		return ylt();
 	else
 		return ylnil();
@@ -174,7 +174,7 @@ YLDEFNF(is_set, 1, 1) {
     ylnfcheck_parameter(ylais_type(ylcar(e), ylaif_sym()));
     /* check global symbol */
     return (ylgsym_get(&temp,
-		       ylasym(ylcar(e)).sym))?
+		       ylasymstr(ylcar(e))))?
 	    ylt():
 	    ylnil();
 } YLENDNF(is_set)
@@ -184,13 +184,13 @@ YLDEFNF(is_tset, 1, 1) {
     ylnfcheck_parameter(ylais_type(ylcar(e), ylaif_sym()));
     return (ylslu_get(cxt->slut,
 		      &temp,
-		      ylasym(ylcar(e)).sym))?
+		      ylasymstr(ylcar(e))))?
 	    ylt():
 	    ylnil();
 } YLENDNF(is_tset)
 
 YLDEFNF(eval, 1, 1) {
-	return yleval(cxt, ylcar(e), a);
+	return yleval_tail(cxt, ylcar(e), a);
 } YLENDNF(eval)
 
 YLDEFNF(help, 1, 9999) {
@@ -200,19 +200,19 @@ YLDEFNF(help, 1, 9999) {
 	while (!yleis_nil(e)) {
 		if (0 > ylgsym_get_description(desc,
 					       __MAX_DESC_SZ,
-					       ylasym(ylcar(e)).sym))
+					       ylasymstr(ylcar(e))))
 			ylprint("======== %s =========\n"
 				"Cannot find symbol\n",
-				ylasym(ylcar(e)).sym);
+				ylasymstr(ylcar(e)));
 		else {
 			short	   outty;
 			yle_t*	   v;
-			v = ylgsym_get(&outty, ylasym(ylcar(e)).sym);
+			v = ylgsym_get(&outty, ylasymstr(ylcar(e)));
 			ylprint("\n======== %s Desc =========\n"
 				"%s\n"
 				"-- Value --\n"
 				"%s : %s\n"
-				, ylasym(ylcar(e)).sym
+				, ylasymstr(ylcar(e))
 				, desc
 				, (YLASym_mac == outty)? "M": ""
 				, ylechain_print(ylethread_buf(cxt), v));
@@ -230,7 +230,7 @@ YLDEFNF(load_cnf, 1, 1) {
 
 	ylnfcheck_parameter(ylais_type_chain(e, ylaif_sym()));
 
-	fname = ylasym(ylcar(e)).sym;
+	fname = ylasymstr(ylcar(e));
 	handle = dlopen(fname, RTLD_LAZY);
 	if (!handle) {
 		ylnflogE("Cannot open custom command library : %s\n",
@@ -266,7 +266,7 @@ YLDEFNF(unload_cnf, 1, 1) {
 
 	ylnfcheck_parameter(ylais_type_chain(e, ylaif_sym()));
 
-	fname = ylasym(ylcar(e)).sym;
+	fname = ylasymstr(ylcar(e));
 	/*
 	 * If the same library is loaded again,
 	 *   the same file handle is returned.
@@ -288,6 +288,8 @@ YLDEFNF(unload_cnf, 1, 1) {
 
 	(*unregister_cnf)(cxt);
 
+	/* atoms of this library may be waiting for finalizer */
+	ylmp_fin_flush();
 	dlclose(handle);
 
 	ylnflogI("done\n");
@@ -303,7 +305,7 @@ YLDEFNF(unload_cnf, 1, 1) {
 YLDEFNF(interpret, 1, 1) {
 	const char* code;
 	ylnfcheck_parameter(ylais_type_chain(e, ylaif_sym()));
-	code = ylasym(ylcar(e)).sym;
+	code = ylasymstr(ylcar(e));
 	if (YLOk != ylinterpret_internal(cxt,
 					 (unsigned char*) code,
 					 (unsigned int) strlen(code))) {
@@ -324,7 +326,7 @@ YLDEFNF(interpret_file, 1, 9999) {
 
 	while (!yleis_nil(e)) {
 		fh = NULL; buf = NULL;
-		fname = ylasym(ylcar(e)).sym;
+		fname = ylasymstr(ylcar(e));
 
 		fh = fopen(fname, "r");
 		if (!fh) {
@@ -378,6 +380,94 @@ YLDEFNF(interpret_file, 1, 9999) {
 	ylinterpret_undefined(YLErr_func_fail); /* error during interpreting */
 } YLENDNF(interpret_file)
 
+/*
+ * prepend '(key v) to 'r'
+ */
+static yle_t*
+_gcstat_add(yle_t* r, const char* key, unsigned long long v) {
+	yle_t* k = ylmp_block();
+	ylaassign_csym(k, key);
+	return ylcons(yllist(k, ylacreate_dbl((double)v)), r);
+}
+
+YLDEFNF(gc_stats, 0, 0) {
+	ylgcstat_t st;
+	yle_t*     r = ylnil();
+	ylgc_stat(&st);
+	/* built in reverse order */
+	r = _gcstat_add(r, "moved",       st.moved);
+	r = _gcstat_add(r, "nr-compact",  st.nr_compact);
+	r = _gcstat_add(r, "lo",          st.lo);
+	r = _gcstat_add(r, "ext-peak",    st.ext_peak);
+	r = _gcstat_add(r, "ext",         st.ext);
+	r = _gcstat_add(r, "bbs-max",     st.bbs_max);
+	r = _gcstat_add(r, "nr-shrink",   st.nr_shrink);
+	r = _gcstat_add(r, "nr-grow",     st.nr_grow);
+	r = _gcstat_add(r, "pool",        st.poolsz);
+	r = _gcstat_add(r, "live",        st.live);
+	r = _gcstat_add(r, "peak",        st.peak);
+	r = _gcstat_add(r, "used",        st.used);
+	r = _gcstat_add(r, "pause-p99",   st.pause_p99);
+	r = _gcstat_add(r, "pause-p90",   st.pause_p90);
+	r = _gcstat_add(r, "pause-p50",   st.pause_p50);
+	r = _gcstat_add(r, "pause-max",   st.pause_max);
+	r = _gcstat_add(r, "pause-total", st.pause_total);
+	r = _gcstat_add(r, "nr-pause",    st.nr_pause);
+	r = _gcstat_add(r, "alloc-rate",  st.alloc_rate);
+	r = _gcstat_add(r, "alloc",       st.alloc);
+	r = _gcstat_add(r, "collected",   st.collected);
+	r = _gcstat_add(r, "nr-full-gc",  st.nr_full_gc);
+	r = _gcstat_add(r, "nr-gc",       st.nr_gc);
+	return r;
+} YLENDNF(gc_stats)
+
+YLDEFNF(gc_compact, 0, 0) {
+	ylgc_compact();
+	return ylt();
+} YLENDNF(gc_compact)
+
+/*
+ * prepend '(name cnt bytes) to 'r'
+ */
+static yle_t*
+_census_add(yle_t* r, const char* name,
+	    unsigned int cnt, unsigned long bytes) {
+	yle_t* k = ylmp_block();
+	ylaassign_csym(k, name);
+	return ylcons(ylcons(k, yllist(ylacreate_dbl((double)cnt),
+				       ylacreate_dbl((double)bytes))),
+		      r);
+}
+
+YLDEFNF(heap_census, 0, 1) {
+	ylcensus_t   c;
+	yle_t       *tys, *syms, *k;
+	int          i;
+
+	ylnfcheck_parameter(pcsz < 1 || ylais_type(ylcar(e), ylaif_sym()));
+	ylmp_census(cxt, &c);
+	if (pcsz > 0 && 0 > ylgc_census_dump(&c, ylasymstr(ylcar(e))))
+		ylnfinterp_fail(YLErr_func_fail,
+				"Fail to write census to [%s]\n",
+				ylasymstr(ylcar(e)));
+
+	/* built in reverse order */
+	tys = syms = ylnil();
+	for (i = c.nty - 1; i >= 0; i--)
+		tys = _census_add(tys, c.ty[i].name,
+				  c.ty[i].cnt, c.ty[i].bytes);
+	for (i = c.ntop - 1; i >= 0; i--)
+		syms = _census_add(syms, c.top[i].sym,
+				   c.top[i].cnt, c.top[i].bytes);
+	k = ylmp_block();
+	ylaassign_csym(k, "types");
+	tys = ylcons(k, tys);
+	k = ylmp_block();
+	ylaassign_csym(k, "symbols");
+	syms = ylcons(k, syms);
+	return yllist(tys, syms);
+} YLENDNF(heap_census)
+
 /**********************************************************
  * Functions for managing interpreter internals.
  **********************************************************/
@@ -65,8 +65,8 @@ YLDEFNF(create_thread, 1, 1) {
 	pthread_t    thd;
 	ylerr_t      r;
 	ylnfcheck_parameter(ylais_type(ylcar(e), ylaif_sym()));
-	r = ylinterpret_async(&thd, (unsigned char*)ylasym(ylcar(e)).sym,
-			      (unsigned int)strlen(ylasym(ylcar(e)).sym));
+	r = ylinterpret_async(&thd, (unsigned char*)ylasymstr(ylcar(e)),
+			      (unsigned int)strlen(ylasymstr(ylcar(e))));
 	if (YLOk == r)
 		/* change thd into double...to use easily in other place */
 		return ylacreate_dbl((double)thd);
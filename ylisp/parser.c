@@ -28,7 +28,10 @@
  */
 
 #include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
 #include "lisp.h"
+#include "mempool.h"
 
 
 
@@ -241,14 +244,48 @@ _fsa_add_symchar(struct _fsa* fsa, char c) {
 
 static inline yle_t*
 _create_atom_sym(unsigned char* sym, unsigned int len) {
-	char* str = ylmalloc(sizeof(char)*(len+1));
+	yle_t* e;
+	char*  str;
+	if (len <= YLSSYM_MAX) {
+		e = ylmp_block();
+		ylaassign_ssym(e, (char*)sym, len);
+		return e;
+	}
+	/* string is copied only if it's not interned yet */
+	str = ylsym_intern((char*)sym, len);
 	if (!str)
 		ylinterp_fail(YLErr_out_of_memory,
 			      "Out Of Memory : [%d]!\n",
 			      len);
-	memcpy(str, sym, len);
-	str[len] = 0; /* ylnull-terminator */
-	return ylacreate_sym(str);
+	e = ylmp_block();
+	ylaassign_isym(e, str);
+	return e;
+}
+
+/*
+ * Numeric literal is classified here - once at parsing time.
+ * Symbol keeps it's string. So, quoted one is still symbol.
+ * Only token starting with digit (sign and '.' may be ahead of it) is
+ *   number. So, 'inf' and 'nan' are normal symbols.
+ */
+static inline void
+_classify_num(yle_t* se) {
+	const char* p = ylasymstr(se);
+	char*       endp;
+	double      d;
+	if ('+' == *p || '-' == *p)
+		p++;
+	if ('.' == *p)
+		p++;
+	if (!isdigit((unsigned char)*p))
+		return;
+	errno = 0;
+	d = strtod(ylasymstr(se), &endp);
+	if (0 == *endp && ERANGE != errno) {
+		yleset_stype(se, YLASym_num);
+		/* value is created once. (See '_aif_sym_visit' at lisp.c) */
+		ylasymc(se) = ylacreate_dbl(d);
+	}
 }
 
 static inline void
@@ -274,7 +311,11 @@ _fsas_init_enter(yletcxt_t* cxt,
 	 * At first, set invalid(NULL) car/cdr
 	 * If not, ylpassign try to unref car/cdr which is invalid address.
 	 */
-	yleset_type(&fsa->sentinel, YLEPair); /* type of sentinel is 'pair' */
+	/*
+	 * type of sentinel is 'pair'
+	 * (set directly - sentinel is not memory block of pool.)
+	 */
+	fsa->sentinel.t = YLEPair;
 	fsa->sentinel.u.p.car = fsa->sentinel.u.p.cdr = NULL;
 
 	fsa->pe = &fsa->sentinel;
@@ -296,6 +337,9 @@ _fsas_init_come_back(yletcxt_t* cxt,
 
 	/* prepare for new interpretation */
 	fsa->pe = &fsa->sentinel;
+
+	/* temporaries of expression are not needed anymore */
+	ylmp_region_end(cxt);
 }
 
 static int
@@ -476,6 +520,7 @@ _fsas_symbol_exit(yletcxt_t* cxt,
 		  const struct _fsas* fsas, struct _fsa* fsa) {
 	yle_t* pair = ylcons(ylnil(), ylnil());
 	yle_t* se = _create_atom_sym(fsa->b, (unsigned int)(fsa->pb - fsa->b));
+	_classify_num(se);
 	ylpsetcar(pair, se);
 	ylpsetcdr(fsa->pe, pair);
 	/* update previous element pointer */
@@ -607,6 +652,8 @@ ylinterp_automata(void* arg) {
 		_mlock(&cxt->m);
 		_munlock(&cxt->m);
 
+		ylmp_bind_cxt(cxt);
+
 		fsa.pb = fsa.b = parg->b;
 		fsa.bend = fsa.b + parg->bsz;
 		fsa.s = parg->s;
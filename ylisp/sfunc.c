@@ -47,6 +47,20 @@ static struct _lfsym {
 	{"flabel",     &_evlf_flabel},
 };
 
+static inline yle_t*
+(*_lfsym_func(const yle_t* s))(yletcxt_t*, yle_t*, yle_t*) {
+	const char*   lfsym = ylasymstr(s);
+	return yltrie_get(_lfsymtab,
+			  (unsigned char*)lfsym,
+			  (unsigned int)strlen(lfsym));
+}
+
+/*
+ * Returned instead of value when tail call is requested.
+ * (See 'yleval_tail')
+ */
+static yle_t _etail;
+
 #ifdef CONFIG_DBG_EVAL
 /*
  * this is for debugging perforce
@@ -125,20 +139,61 @@ yleq(const yle_t* e1, const yle_t* e2) {
  * Recursive S-functions - START
  *=================================*/
 
+/*
+ * Local association list
+ * ----------------------
+ * Each call of 'lambda' / 'flabel' adds a frame - one entry (u v) per
+ *   parameter - in front of the list. So, list is a stack of frames, and
+ *   the innermost binding is found first.
+ * Lambda body sees bindings of its caller (dynamic scope), and binding
+ *   can be changed by 'set'. So, place of binding cannot be fixed before
+ *   evaluation, and symbol is looked up by walking the list.
+ * Walking is done in a loop, and symbol is compared by its interned string
+ *   directly - without 'yleq'.
+ */
+
+/*
+ * Is 'u' symbol whose string is same with symbol 'x'?
+ * (See '_aif_sym_eq')
+ */
+static inline int
+_sym_same(const yle_t* u, const yle_t* x) {
+	return u == x
+		|| (ylaif_sym() == ylaif(u)
+		    && ylasym(u).str.i == ylasym(x).str.i
+		    && ylasym_is_short(u) == ylasym_is_short(x));
+}
+
 /**
  * assumption : x is atomic symbol, y is a list form ((u1 v1) ...)
  * @return NULL if fail to find. container ylpair if found.
  */
 static inline yle_t*
 _list_find(yle_t* x, yle_t* y) {
-	if ( yleis_atom(y) || yleis_atom(ylcar(y)) )
-		/* check that y is empty list or not. NIL also atom! */
-		return NULL;
+	/* check that y is empty list or not. NIL also atom! */
+	for (; !yleis_atom(y) && !yleis_atom(ylpcar(y)); y = ylpcdr(y))
+		if (_sym_same(ylcaar(y), x))
+			return ylpcar(y);
+	return NULL;
+}
+
+/*
+ * Add frame binding parameters 'x' to arguments 'y', in front of 'a'.
+ * frame [x; y; a] = [null [x] && null [y] -> a;
+ *                    !atom [x] && !atom [y] -> cons [list [car [x]; car [y]];
+ *                                                    frame [cdr [x]; cdr [y]; a]]
+ * This is 'append [pair [x; y]; a]' without copying list made by 'pair'.
+ */
+static yle_t*
+_frame(yle_t* x, yle_t* y, yle_t* a) {
+	if (yleis_nil(x) && yleis_nil(y))
+		return a;
+	else if (!yleis_atom(x) && !yleis_atom(y))
+		return ylcons(yllist(ylcar(x), ylcar(y)),
+			      _frame(ylcdr(x), ylcdr(y), a));
 	else
-		if ( yleis_true(yleq(ylcaar(y), x)) )
-			return ylcar(y);
-		else
-			return _list_find(x, ylcdr(y));
+		ylinterp_fail(YLErr_eval_undefined,
+			      "Fail to map parameter!\n");
 }
 
 
@@ -185,11 +240,11 @@ _set(yletcxt_t* cxt,
 		ylinterp_fail(YLErr_eval_undefined,
 			      "Only symbol can be set!\n");
 
-	if (0 == *ylasym(s).sym)
+	if (0 == *ylasymstr(s))
 		ylinterp_fail(YLErr_eval_undefined,
 			      "empty symbol cannot be set!\n");
 
-	ylassert(ylasym(s).sym);
+	ylassert(ylasymstr(s));
 	r = _list_find(s, a);
 	if (r) {
 		/* found it */
@@ -199,17 +254,17 @@ _set(yletcxt_t* cxt,
 				      "unexpected set operation!\n");
 		else  {
 			ylassert(ylais_type(ylcar(r), ylaif_sym()));
-			ylestype(ylcar(r)) = ty;
+			yleset_stype(ylcar(r), ty);
 			/* change value of local map yllist */
 			ylpsetcdr(r, ylcons(val, ylnil()));
 		}
 		/* argument desc is ignored */
 	} else {
-		_set_insert(cxt, ylasym(s).sym, ty, val, bgsym);
+		_set_insert(cxt, ylasymstr(s), ty, val, bgsym);
 		/* NULL or strlen (desc) == 0 : only trailing 0 */
 		if (!desc || !desc[0])
 			desc = NULL;
-		_set_description(cxt, ylasym(s).sym, ty, desc, bgsym);
+		_set_description(cxt, ylasymstr(s), ty, desc, bgsym);
 	}
 	return val;
 }
@@ -232,11 +287,15 @@ int
 ylis_set(yletcxt_t* cxt, yle_t* a, const char* sym) {
 	yle_t  etmp;
 	short  temp;
-	/* etmp is never cleaned. So, sym can be used directly here */
-	ylaassign_sym(&etmp, (char*)sym);
-	return NULL != _list_find(&etmp, a) ||
+	int    r;
+	etmp.t = 0; /* etmp is not block of memory pool - no GC bits */
+	ylaassign_csym(&etmp, sym);
+	r = NULL != _list_find(&etmp, a) ||
 		NULL != ylslu_get(cxt->slut, &temp, sym) ||
 		NULL != ylgsym_get(&temp, sym);
+	/* etmp is not in memory pool. So, it's never cleaned by GC. */
+	yleclean(&etmp);
+	return r;
 }
 
 /*
@@ -291,38 +350,99 @@ _mreplace(yle_t* e, yle_t* a) {
 	return r;
 }
 
+/*
+ * Call-site cache
+ * ---------------
+ * Slot of value found in global symbol table is cached at symbol atom of
+ *   the expression - call-site - with generation of symbol tables.
+ *     ylasymslot(x) : slot of value (See 'sluv_t')
+ *     ylasymtag(x)  : generation | type of symbol (YLASym_def or YLASym_mac)
+ * Cache is valid while generation is not changed. (See 'ylg_slu_gen')
+ * Re-assigning global symbol changes value in the slot. So, it doesn't
+ *   invalidate cache.
+ * Tag is 0 if nothing is cached, and 1 while slot is written.
+ * Reader who sees same valid tag before and after reading slot, gets
+ *   consistent slot. Slot of deleted symbol may be reused. So, generation is
+ *   checked again after reading value from it.
+ * Per-thread symbol may shadow global one. So, cache is used only if
+ *   there is no per-thread symbol in this thread.
+ * Value of numeric symbol shares the field with slot. Numeric symbol is
+ *   never looked up, so it's never cached and it's tag is always 0.
+ *   (See '_lookup')
+ */
+#define _CACHE_BUSY 1
+
+static inline yle_t*
+_cache_get(yletcxt_t* cxt, short* ovty, yle_t* x) {
+	volatile unsigned int* tagp = &ylasymtag(x);
+	unsigned int           tag = *tagp;
+	sluv_t*                s;
+	yle_t*                 r;
+	if ((tag & ~1u) != ylg_slu_gen || ylslu_nr(cxt->slut))
+		return NULL;
+	/* Only loads are ordered. Full barrier is too heavy here */
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	s = ylasymslot(x);
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	if (tag != *tagp)
+		return NULL;
+	r = s->e;
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	/* slot is deleted, and may be reused */
+	if ((tag & ~1u) != ylg_slu_gen)
+		return NULL;
+	*ovty = tag & 1;
+	return r;
+}
+
+/*
+ * @gen : generation read before looking up 's'
+ */
+static inline void
+_cache_set(yle_t* x, sluv_t* s, short ty, unsigned int gen) {
+	unsigned int tag = ylasymtag(x);
+	/* field of slot is value of numeric symbol */
+	ylassert(YLASym_num != ylestype(x));
+	if (_CACHE_BUSY == tag
+	    || (YLASym_def != ty && YLASym_mac != ty)
+	    /* somebody else is writing */
+	    || !__sync_bool_compare_and_swap(&ylasymtag(x), tag, _CACHE_BUSY))
+		return;
+	ylasymslot(x) = s;
+	__sync_synchronize();
+	ylasymtag(x) = gen | ty;
+}
+
 /**
  * y is a yllist of the form ((u1 v1) ... (uN vN)) yland x is one of u's then
  * assoc [x; y] = yleq [ylcaar [y]; x] -> ylcadr [y]; T -> assoc [x; ylcdr[y]]
  *
  * < additional constraints : x is atomic >
+ * Value of macro symbol is returned as it is. (See '_assoc')
+ * @bloc [out] : 1 if found in local association list.
  */
-static const yle_t*
-_assoc(yletcxt_t* cxt, short* ovty, yle_t* x, yle_t* y) {
-	yle_t* r;
+static yle_t*
+_lookup(yletcxt_t* cxt, short* ovty, int* bloc, yle_t* x, yle_t* y) {
+	yle_t*       r;
+	sluv_t*      s;
+	unsigned int gen;
+	*bloc = 0;
 	if (!ylais_type(x, ylaif_sym()))
 		ylinterp_fail(YLErr_eval_undefined,
 			      "Only symbol can be associated!\n");
 
 	/*
-	 * !! IMPORTANT NOTE !!
-	 *    This SHOULD NOT BE THE ONE IN GLOBAL SPACE!!
-	 *    Expression should be preserved!
-	 *    Concept of macro(mset/mlambda) is different from 'set/lambda'.
-	 *    Concept is NOT "get and use stored data".
-	 *        - in this context, retrieved data can be changed!.
-	 *    But, concept is "Replace it with pre-defined expression!"
-	 *        - in this context, pre-defined expression SHOULD NOT
-	 *           be changed at any cases.
-	 *    So, we should use cloned one!
-	 *
-	 * !! IMPORTANT NOTE !!
-	 *    Current implementation DOESN"T clone any ATOM DATA!
-	 *      (see '_list_clone')
-	 *    So, chaning atom directly affects to global macro!!!
-	 *    (This is NOT BUG. It's implementation CONCEPT!)
-	 *
+	 * Numeric literal is classified by parser.
+	 * (See '_classify_num' at parser.c)
+	 * Number is never looked up in symbol space.
+	 * So, binding to numeric symbol - ex. (set '12 5) - doesn't change
+	 *   value of literal '12'.
 	 */
+	if (YLASym_num == ylestype(x)) {
+		*ovty = 0;
+		return ylasymc(x);
+	}
+
 	do {
 		/*
 		 * Policy:
@@ -335,21 +455,29 @@ _assoc(yletcxt_t* cxt, short* ovty, yle_t* x, yle_t* y) {
 			/* Found! in local association list */
 			ylassert(ylais_type(ylcar(r), ylaif_sym()));
 			*ovty = ylestype(ylcar(r));
+			*bloc = 1;
 			r = ylcadr(r);
 			break;
 		}
 
+		r = _cache_get(cxt, ovty, x);
+		if (r)
+			break;
+
 		/* Find in per-thread symbol table! */
-		r = (yle_t*)ylslu_get(cxt->slut, ovty, ylasym(x).sym);
+		r = (yle_t*)ylslu_get(cxt->slut, ovty, ylasymstr(x));
 		if (r)
 			break;
 
 		/* At last find in global symbol table */
-		r = (yle_t*)ylgsym_get(ovty, ylasym(x).sym);
+		gen = ylg_slu_gen;
+		r = (yle_t*)ylgsym_get_slot(ovty, &s, ylasymstr(x));
+		if (r)
+			_cache_set(x, s, *ovty, gen);
 	} while (0);
 
 	if (r)
-		return (*ovty == YLASym_mac)? _list_clone(r): r;
+		return r;
 
 	/* check that this is numeric symbol */
 	{ /* Just Scope */
@@ -360,7 +488,8 @@ _assoc(yletcxt_t* cxt, short* ovty, yle_t* x, yle_t* y) {
 		 */
 		char*   endp;
 		double  d;
-		d = strtod(ylasym(x).sym, &endp);
+		errno = 0;
+		d = strtod(ylasymstr(x), &endp);
 		if ( 0 == *endp && ERANGE != errno ) {
 			/* default is 0 */
 			*ovty = 0;
@@ -369,10 +498,39 @@ _assoc(yletcxt_t* cxt, short* ovty, yle_t* x, yle_t* y) {
 		}
 		ylinterp_fail(YLErr_eval_undefined,
 			      "symbol [%s] was not set!\n",
-			      ylasym(x).sym);
+			      ylasymstr(x));
 	}
 }
 
+/*
+ * Value of macro symbol is cloned.
+ */
+static const yle_t*
+_assoc(yletcxt_t* cxt, short* ovty, yle_t* x, yle_t* y) {
+	int     bloc;
+	yle_t*  r = _lookup(cxt, ovty, &bloc, x, y);
+	/*
+	 * !! IMPORTANT NOTE !!
+	 *    This SHOULD NOT BE THE ONE IN GLOBAL SPACE!!
+	 *    Expression should be preserved!
+	 *    Concept of macro(mset/mlambda) is different from 'set/lambda'.
+	 *    Concept is NOT "get and use stored data".
+	 *        - in this context, retrieved data can be changed!.
+	 *    But, concept is "Replace it with pre-defined expression!"
+	 *        - in this context, pre-defined expression SHOULD NOT
+	 *           be changed at any cases.
+	 *    So, we should use cloned one!
+	 *
+	 * !! IMPORTANT NOTE !!
+	 *    Current implementation DOESN"T clone any ATOM DATA!
+	 *      (see '_list_clone')
+	 *    So, chaning atom directly affects to global macro!!!
+	 *    (This is NOT BUG. It's implementation CONCEPT!)
+	 *
+	 */
+	return (*ovty == YLASym_mac)? _list_clone(r): r;
+}
+
 /*=================================
  * Recursive S-functions - END
  *=================================*/
@@ -390,7 +548,7 @@ _evatom_form(yletcxt_t* cxt, yle_t* e, yle_t* a) {
 	if (ylaif_sym() == ylaif(e)) {
 		r = (yle_t*)_assoc(cxt, &vty, e, a);
 		if (YLASym_mac == vty)
-			r = yleval(cxt, r, a);
+			r = yleval_tail(cxt, r, a);
 	} else
 		ylinterp_fail(YLErr_eval_undefined,
 "ERROR to evaluate atom(only symbol can be evaluated!.\n"
@@ -399,6 +557,139 @@ _evatom_form(yletcxt_t* cxt, yle_t* e, yle_t* a) {
 	return r;
 }
 
+/*
+ * Expand mlambda form 'e' - (mlambda-expression arg1 arg2 ...).
+ */
+static yle_t*
+_mlambda_expand(yle_t* e) {
+	yle_t* r = NULL;
+
+	if (yleis_nil(ylcadar(e)) && !yleis_nil(ylcaddar(e))) {
+		/*
+		 * !!! Special usage of mlambda !!!
+		 * If parameter is nil, than,
+		 *   arguments are appended to the body!
+		 */
+
+		/*
+		 * At below, we should change cdr value.
+		 * In case of MT evaluation, this may cause racing condition.
+		 * Use list-copied one!
+		 */
+		yle_t* exp = _list_clone(ylcaddar(e));
+		yle_t* we = exp;
+		while (!yleis_nil(ylcdr(we)))
+			we = ylcdr(we);
+
+		/* connect body with argument */
+		ylpsetcdr(we, ylcdr(e));
+		r = exp;
+		/* we don't need to restore. it was just copied one. */
+		/* ylpsetcdr(we, ylnil()); */
+	} else {
+		/*
+		 * NOTE!!
+		 *     expression itself may be changed in '_mreplace'.
+		 *     To reserve original expression, we need to use cloned one.
+		 *  --> Now expression is preserved!
+		 */
+		yle_t* exp = _list_clone(ylcaddar(e));
+		if (0 > _mreplace(exp, _frame(ylcadar(e), ylcdr(e), ylnil())))
+			ylinterp_fail(YLErr_eval_undefined,
+				      "Fail to mreplace!!\n");
+		else
+			r = exp;
+	}
+	return r;
+}
+
+/*
+ * Macro expansion cache
+ * ---------------------
+ * Call expression whose head is macro symbol, is replaced with expansion
+ *   of macro value - clone of it, or result of '_mreplace' for mlambda.
+ * Expansion depends only on the call expression and the macro value.
+ *   So, it's cached per call expression, and used while symbol has same
+ *   value. Setting macro symbol again gives new value - new generation
+ *   of macro - and cached expansion is not used any more.
+ * Cache is per-thread and direct-mapped. Entries are not GC roots.
+ *   Entry whose call expression or macro value is garbage, is dropped at
+ *   the end of marking. So, expansions of garbage - ex. call expressions
+ *   in clone of function body - are not kept by cache.
+ *   (Entries are dropped at compaction, too.)
+ * Atoms are not cloned at expansion, as before. And expansion is shared
+ *   by evaluations of the call expression.
+ * Pair may be changed in place - ex. 'setcar'. Then, cached expansion
+ *   - or value stored from it by 'mset' - may be the one changed.
+ *   So, every entry is invalidated by bumping generation of cache.
+ *   (See 'ylmcache_invalidate')
+ *
+ * Value bound at local association list - ex. function name bound by
+ *   'flabel' - is expanded with clone too. But it's not cached. Call
+ *   expressions in the clone are new ones at every recursive call. So,
+ *   they never hit, and just push out others.
+ */
+static volatile unsigned int _mcgen;
+
+static inline unsigned int
+_mcache_idx(const yle_t* e) {
+	/* blocks are aligned. Low bits are meaningless */
+	return (unsigned int)((unsigned long)e / sizeof(yle_t))
+		& (YLMCACHESZ - 1);
+}
+
+void
+ylmcache_gcmark(yletcxt_t* cxt) {
+	unsigned int i;
+	for (i = 0; i < YLMCACHESZ; i++) {
+		if (!cxt->mc[i].e)
+			continue;
+		if (yleis_gcmark(cxt->mc[i].e) && yleis_gcmark(cxt->mc[i].r))
+			ylmp_gcmark(cxt->mc[i].x);
+		else
+			cxt->mc[i].e = NULL;
+	}
+}
+
+void
+ylmcache_clear(yletcxt_t* cxt) {
+	memset(cxt->mc, 0, sizeof(cxt->mc));
+}
+
+void
+ylmcache_invalidate(void) {
+	__sync_add_and_fetch(&_mcgen, 1);
+}
+
+/*
+ * Get expansion of call expression 'e' whose head is macro symbol.
+ * @r    : value of macro symbol. (not cloned)
+ * @bloc : 'r' is bound at local association list.
+ */
+static yle_t*
+_mexpand(yletcxt_t* cxt, yle_t* e, yle_t* r, int bloc) {
+	unsigned int i = _mcache_idx(e);
+	unsigned int gen = _mcgen; /* read before expanding */
+	yle_t*       x;
+	if (cxt->mc[i].e == e && cxt->mc[i].r == r && cxt->mc[i].gen == gen)
+		return cxt->mc[i].x;
+
+	if (!yleis_atom(r)
+	    && ylais_type(ylcar(r), ylaif_sym())
+	    && &_evlf_mlambda == _lfsym_func(ylcar(r)))
+		x = _mlambda_expand(ylcons(r, ylcdr(e)));
+	else
+		x = ylcons(_list_clone(r), ylcdr(e));
+
+	if (bloc)
+		return x;
+	cxt->mc[i].e = e;
+	cxt->mc[i].r = r;
+	cxt->mc[i].x = x;
+	cxt->mc[i].gen = gen;
+	return x;
+}
+
 static yle_t*
 _evfunc_form(yletcxt_t* cxt, yle_t* e, yle_t* a) {
 	/*
@@ -406,17 +697,18 @@ _evfunc_form(yletcxt_t* cxt, yle_t* e, yle_t* a) {
 	 */
 	yle_t*   r = NULL;
 	short    vty;
+	int      bloc;
 
 	if (ylaif_sym() != ylaif(ylcar(e)))
 		goto bail;
 
-	r = (yle_t*)_assoc(cxt, &vty, ylcar(e), a);
+	r = _lookup(cxt, &vty, &bloc, ylcar(e), a);
 	if (YLASym_mac == vty)
 		/*
 		 * This is macro symbol! replace target expression with symbol.
 		 * And evaluate it with replaced value!
 		 */
-		r = yleval(cxt, ylcons(r, ylcdr(e)), a);
+		r = yleval_tail(cxt, _mexpand(cxt, e, r, bloc), a);
 	else {
 		if (!yleis_atom(r))
 			goto bail;
@@ -463,7 +755,7 @@ _evlf_lambda(yletcxt_t* cxt, yle_t* e, yle_t* a) {
 	 * eq [caar [e] -> LAMBDA]
 	 *  -> eval [caddar [e];
 	 *           append [pair [cadar [e]; evlis [cdr [e]; a]]; a]]
-	 * ylpair and ylappend don't call yleval in it.
+	 * '_frame' doesn't call yleval in it.
 	 * So, we don't need to preserve base blocks explicitly
 	 *
 	 * car     : lambda expression list
@@ -471,57 +763,14 @@ _evlf_lambda(yletcxt_t* cxt, yle_t* e, yle_t* a) {
 	 * cadar   : arguement list
 	 * caddar  : lambda body
 	 */
-	return yleval(cxt,
-		      ylcaddar(e),
-		      ylappend(ylpair(ylcadar(e),
-				      ylevlis(cxt, ylcdr(e),a)),
-			       a));
+	return yleval_tail(cxt,
+			   ylcaddar(e),
+			   _frame(ylcadar(e), ylevlis(cxt, ylcdr(e), a), a));
 }
 
 static yle_t*
 _evlf_mlambda(yletcxt_t* cxt, yle_t* e, yle_t* a) {
-	yle_t* r = NULL;
-
-	if (yleis_nil(ylcadar(e)) && !yleis_nil(ylcaddar(e))) {
-		/*
-		 * !!! Special usage of mlambda !!!
-		 * If parameter is nil, than,
-		 *   arguments are appended to the body!
-		 */
-
-		/*
-		 * At below, we should change cdr value.
-		 * In case of MT evaluation, this may cause racing condition.
-		 * Use list-copied one!
-		 */
-		yle_t* exp = _list_clone(ylcaddar(e));
-		yle_t* we = exp;
-		while (!yleis_nil(ylcdr(we)))
-			we = ylcdr(we);
-
-		/* connect body with argument */
-		ylpsetcdr(we, ylcdr(e));
-		r = yleval(cxt, exp, a);
-		/* we don't need to restore. it was just copied one. */
-		/* ylpsetcdr(we, ylnil()); */
-	} else {
-		/*
-		 * NOTE!!
-		 *     expression itself may be changed in '_mreplace'.
-		 *     To reserve original expression, we need to use cloned one.
-		 *  --> Now expression is preserved!
-		 */
-		yle_t* exp = _list_clone(ylcaddar(e));
-		if (0 > _mreplace(exp,
-				  ylappend(ylpair(ylcadar(e),
-						  ylcdr(e)),
-					   ylnil())))
-			ylinterp_fail(YLErr_eval_undefined,
-				      "Fail to mreplace!!\n");
-		else
-			r = yleval(cxt, exp, a);
-	}
-	return r;
+	return yleval_tail(cxt, _mlambda_expand(e), a);
 }
 
 static yle_t*
@@ -541,9 +790,9 @@ _evlf_label(yletcxt_t* cxt, yle_t* e, yle_t* a) {
 	 *            cons [list [cadar [e]; car [e]];
 	 *            a]]
 	 */
-	return yleval(cxt,
-		      ylcons(ylcaddar(e), ylcdr(e)),
-		      ylcons(yllist(ylcadar(e), ylcar(e)), a));
+	return yleval_tail(cxt,
+			   ylcons(ylcaddar(e), ylcdr(e)),
+			   ylcons(yllist(ylcadar(e), ylcar(e)), a));
 }
 
 static yle_t*
@@ -592,9 +841,9 @@ _evlf_flabel(yletcxt_t* cxt, yle_t* e, yle_t* a) {
 		ylinterp_fail(YLErr_eval_undefined,
 			      "flabel name should be symbol!\n");
 	/* set symbol type as macro */
-	ylestype(fln) = YLASym_mac;
-	param_assoc = ylpair(fla, ylevlis(cxt, flp, a));
-	return yleval(cxt, fle, ylcons(yllist(fln, fl), param_assoc));
+	yleset_stype(fln, YLASym_mac);
+	param_assoc = _frame(fla, ylevlis(cxt, flp, a), ylnil());
+	return yleval_tail(cxt, fle, ylcons(yllist(fln, fl), param_assoc));
 }
 
 static yle_t*
@@ -610,21 +859,14 @@ _evlambda_form(yletcxt_t* cxt, yle_t* e, yle_t* a) {
 "First element of lambda format SHOULD be a symbol-type-atom\n"
 			      );
 
-	{ /* Just Scope */
-		const char*   lfsym;
-		lfsym = ylasym(ylcaar(e)).sym;
-		lffunc = yltrie_get(_lfsymtab,
-				    (unsigned char*)lfsym,
-				    (unsigned int)strlen(lfsym));
-	}
-
+	lffunc = _lfsym_func(ylcaar(e));
 	if (lffunc)
 		return (*lffunc)(cxt, e, a);
 	else {
 		/* my extention */
-		return yleval(cxt,
-			      ylcons(yleval(cxt, ylcar(e), a), ylcdr(e)),
-			      a);
+		return yleval_tail(cxt,
+				   ylcons(yleval(cxt, ylcar(e), a), ylcdr(e)),
+				   a);
 		/* ylinterpret_undefined(YLErr_eval_undefined); */
 	}
 }
@@ -653,14 +895,35 @@ yleval(yletcxt_t* cxt, yle_t* e, yle_t* a) {
 	 */
 	ylmp_add_bb2(e, a);
 
-	if (yleis_atom(e))
-		r = _evatom_form(cxt, e, a);
-	else if (yleis_atom(ylcar(e)))
-		r = _evfunc_form(cxt, e, a);
-	else if (yleis_atom(ylcaar(e)))
-		r = _evlambda_form(cxt, e, a);
-	else ylinterp_fail(YLErr_eval_undefined,
-			   "(((xxx))) format is not allowed to evaluate!\n");
+	for (;;) {
+		if (yleis_atom(e))
+			r = _evatom_form(cxt, e, a);
+		else if (yleis_atom(ylcar(e)))
+			r = _evfunc_form(cxt, e, a);
+		else if (yleis_atom(ylcaar(e)))
+			r = _evlambda_form(cxt, e, a);
+		else ylinterp_fail(YLErr_eval_undefined,
+"(((xxx))) format is not allowed to evaluate!\n");
+
+		if (&_etail != r)
+			break;
+		/*
+		 * Tail call is requested. (See 'yleval_tail')
+		 * Evaluate it in this frame instead of the current one.
+		 * Requested 'e' and 'a' are kept by context until now.
+		 * Current 'e' and 'a' are at the top of base blocks. So,
+		 *   replacing them doesn't search base blocks.
+		 */
+		ylmp_rm_bb2(e, a);
+		e = cxt->tle;
+		a = cxt->tla;
+		ylmp_add_bb2(e, a);
+		cxt->tle = cxt->tla = NULL;
+		ylstk_pop(cxt->evalstk);
+		ylstk_push(cxt->evalstk, (void*)e);
+		/* Tail recursive loop should also be interruptible */
+		ylmt_safepoint(cxt);
+	}
 
 	if (!r) ylinterp_fail(YLErr_eval_undefined,
 			      "NULL return! is it possible!\n");
@@ -687,12 +950,12 @@ yleval(yletcxt_t* cxt, yle_t* e, yle_t* a) {
 	 * - Parameter's are kept from GC.
 	 * Now interrupting is acceptable!
 	 * Let's notify memory module that evaluation thread is in safe state!
+	 * (Only when someone requests safe point. See 'ylmt_safepoint')
 	 * (I need to find more places to put this function!.
 	 *    -> make SW stable! And then find more places!
 	 *    [ex. Starting point of evaluation!])
 	 */
-	ylmt_notify_safe(cxt);
-	ylmt_notify_unsafe(cxt);
+	ylmt_safepoint(cxt);
 
 	/*
 	 * Pass responsibility about preserving return value
@@ -704,6 +967,18 @@ yleval(yletcxt_t* cxt, yle_t* e, yle_t* a) {
 }
 
 
+yle_t*
+yleval_tail(yletcxt_t* cxt, yle_t* e, yle_t* a) {
+	/*
+	 * Context keeps them from GC until 'yleval' takes them.
+	 * Pushing them to base blocks here, would make base blocks of
+	 *   caller be removed from the middle of stack.
+	 */
+	cxt->tle = e;
+	cxt->tla = a;
+	return &_etail;
+}
+
 /**
  * appq [m] = [null [m] -> NIL; 
  *            T -> cons [list [QUOTE; car [m]]; appq[ cdr [m]]]]
@@ -724,6 +999,11 @@ ylapply(yletcxt_t* cxt, yle_t* f, yle_t* args, yle_t* a) {
 	return yleval(cxt, ylcons(f, _appq(args)), a);
 }
 
+yle_t*
+ylapply_tail(yletcxt_t* cxt, yle_t* f, yle_t* args, yle_t* a) {
+	return yleval_tail(cxt, ylcons(f, _appq(args)), a);
+}
+
 /*=================================
  * Universal S-functions - END
  *=================================*/
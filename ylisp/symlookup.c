@@ -28,16 +28,18 @@
 
 #include <string.h>
 #include "lisp.h"
+#include "mempool.h"
 
 
-struct _value {
-	/* this should matches symbol atom type - see 'yle_t.sty' for symbol */
-	short      ty;
-
-	/* description for this value */
-	char*      desc;
-
-	yle_t*     e;
+struct _sSlut {
+	yltrie_t*     t;
+	unsigned int  nr;  /* number of symbols in the table */
+	/*
+	 * 1 if values can be cached at call-site. (See 'ylslu_create')
+	 * Then, slot of deleted symbol is kept at 'fr' to be reused.
+	 */
+	int           cached;
+	sluv_t*       fr;  /* list of free slots - linked by 'desc' */
 };
 
 /*
@@ -45,15 +47,22 @@ struct _value {
  */
 static char              _dummy_empty_desc = 0;
 
+volatile unsigned int    ylg_slu_gen = 2;
+
 static inline void
 _free_description(char* desc) {
 	if (&_dummy_empty_desc != desc && desc)
 		ylfree(desc);
 }
 
-static inline struct _value*
-_alloc_value(short sty, yle_t* e) {
-	struct _value* v = ylmalloc(sizeof(*v));
+static inline sluv_t*
+_alloc_value(slut_t* t, short sty, yle_t* e) {
+	sluv_t* v;
+	if (t->fr) {
+		v = t->fr;
+		t->fr = (sluv_t*)v->desc;
+	} else
+		v = ylmalloc(sizeof(*v));
 	if (!v)
 		/*
 		 * if allocing such a small size of memory fails,
@@ -68,7 +77,7 @@ _alloc_value(short sty, yle_t* e) {
 }
 
 static inline void
-_free_value(struct _value* v) {
+_free_value(sluv_t* v) {
 	_free_description(v->desc);
 	/*
 	 * we don't need to free 'v->e' explicitly here!
@@ -77,63 +86,128 @@ _free_value(struct _value* v) {
 	ylfree(v);
 }
 
+/*
+ * Slot may be read at call-site cache while it's deleted.
+ * So, it's kept to be reused instead of being freed.
+ */
+static inline void
+_retire_value(slut_t* t, sluv_t* v) {
+	_free_description(v->desc);
+	v->e = NULL;
+	v->desc = (char*)t->fr;
+	t->fr = v;
+}
+
+static int
+_cb_free_value(void* user,
+	       const unsigned char* key, unsigned int sz,
+	       sluv_t* v) {
+	_free_value(v);
+	return 1;
+}
+
+static inline void
+_bump_gen(void) {
+	/* 0 is never used as generation. (See 'ylg_slu_gen') */
+	if (!__sync_add_and_fetch(&ylg_slu_gen, 2))
+		__sync_add_and_fetch(&ylg_slu_gen, 2);
+}
+
 slut_t*
-ylslu_create(void) {
-	return (slut_t*)yltrie_create( (void(*)(void*))&_free_value );
+ylslu_create(int cached) {
+	slut_t* t = ylmalloc(sizeof(*t));
+	if (!t)
+		ylassert(0);
+	/* values are freed by table itself. (See 'ylslu_delete') */
+	t->t = yltrie_create(NULL);
+	t->nr = 0;
+	t->cached = cached;
+	t->fr = NULL;
+	return t;
 }
 
 void
 ylslu_destroy(slut_t* t) {
-	yltrie_destroy((yltrie_t*)t);
+	sluv_t* v;
+	yltrie_full_walk(t->t, NULL, (void*)&_cb_free_value);
+	yltrie_destroy(t->t);
+	while (t->fr) {
+		v = t->fr;
+		t->fr = (sluv_t*)v->desc;
+		ylfree(v);
+	}
+	ylfree(t);
+}
+
+unsigned int
+ylslu_nr(slut_t* t) {
+	return t->nr;
 }
 
 int
 ylslu_insert(slut_t* t, const char* sym, short sty, yle_t* e) {
 	int              ret;
-	struct _value*   v;
+	sluv_t*          v;
 	unsigned int     slen;
-	struct _value*   ov;
-	v = _alloc_value(sty, e);
 	slen = strlen(sym);
-	ov = yltrie_get((yltrie_t*)t, (unsigned char*)sym, slen);
-	if (ov) {
-		if (ylais_type (v->e, ylaif_nfunc ())
-		    || ylais_type (v->e, ylaif_sfunc ()))
+	v = yltrie_get(t->t, (unsigned char*)sym, slen);
+	if (v) {
+		if (ylais_type (e, ylaif_nfunc ())
+		    || ylais_type (e, ylaif_sfunc ()))
 			yllogW(
 "Warn : native function symbol is overwrittened\n"
 "    -> %s\n",
                                sym
 			       );
 		/*
-		 * in case of overwritten, description should be preserved.
-		 * If this twice-search is bottle-neck of performance,
-		 *   we can reduce overhead by setting value directly
-		 *   to the existing 'ov'.
-		 * By doing this, we can recduce cost
-		 * by saving 1-trie-seach and 1-freeing-trie-node.
-		 * (But in my opinion, it's not big deal!
-		 *   We whould better not to write hard-to-read-code.)
+		 * Value is changed in place. So, description is preserved,
+		 *   and value cached at call-site is still valid.
+		 * But, type is also cached. So, cache should be invalidated
+		 *   before new value of another type is seen.
 		 */
-		v->desc = ov->desc;
-		/* to prevent from freeing inside trie! - HACK */
-		ov->desc = &_dummy_empty_desc;
+		if (v->ty != sty) {
+			if (t->cached)
+				_bump_gen();
+			v->ty = sty;
+		}
+		v->e = e;
+		return 1; /* overwritten */
 	}
-	ret = yltrie_insert((yltrie_t*)t, (unsigned char*)sym, slen, (void*)v);
-
+	v = _alloc_value(t, sty, e);
+	ret = yltrie_insert(t->t, (unsigned char*)sym, slen, (void*)v);
+	if (0 > ret) {
+		_free_value(v);
+		return ret;
+	}
+	t->nr++;
+	if (t->cached)
+		_bump_gen();
 	return ret;
 }
 
 int
 ylslu_delete(slut_t* t, const char* sym) {
 	int         ret;
-	ret = yltrie_delete((yltrie_t*)t, (unsigned char*)sym, strlen(sym));
+	sluv_t*     v;
+	unsigned int slen = strlen(sym);
+	v = yltrie_get(t->t, (unsigned char*)sym, slen);
+	ret = yltrie_delete(t->t, (unsigned char*)sym, slen);
+	if (0 <= ret) {
+		t->nr--;
+		if (t->cached) {
+			/* slot is invalidated before it's reused */
+			_bump_gen();
+			_retire_value(t, v);
+		} else
+			_free_value(v);
+	}
 	return ret;
 }
 
 int
 ylslu_set_description(slut_t* t, const char* sym, const char* description) {
-	struct _value*     v;
-	v = yltrie_get((yltrie_t*)t, (unsigned char*)sym, strlen(sym));
+	sluv_t*     v;
+	v = yltrie_get(t->t, (unsigned char*)sym, strlen(sym));
 	if (v) {
 		unsigned int sz;
 		char*        desc;
@@ -157,15 +231,15 @@ ylslu_set_description(slut_t* t, const char* sym, const char* description) {
 
 const char*
 ylslu_get_description(slut_t* t, const char* sym) {
-	struct _value*     v;
-	v = yltrie_get((yltrie_t*)t, (unsigned char*)sym, strlen(sym));
+	sluv_t*     v;
+	v = yltrie_get(t->t, (unsigned char*)sym, strlen(sym));
 	return v? v->desc: NULL;
 }
 
 yle_t*
 ylslu_get(slut_t* t, short* outty, const char* sym) {
-	struct _value*     v;
-	v = yltrie_get((yltrie_t*)t, (unsigned char*)sym, strlen(sym));
+	sluv_t*     v;
+	v = yltrie_get(t->t, (unsigned char*)sym, strlen(sym));
 	if (v) {
 		if (outty)
 			*outty = v->ty;
@@ -174,28 +248,78 @@ ylslu_get(slut_t* t, short* outty, const char* sym) {
 		return NULL;
 }
 
-_DEF_VISIT_FUNC(static, _gcmark, ,!yleis_gcmark(e), yleset_gcmark(e))
+yle_t*
+ylslu_get_slot(slut_t* t, short* outty, sluv_t** slot, const char* sym) {
+	sluv_t*     v;
+	v = yltrie_get(t->t, (unsigned char*)sym, strlen(sym));
+	*slot = v;
+	if (v) {
+		if (outty)
+			*outty = v->ty;
+		return v->e;
+	} else
+		return NULL;
+}
 
 static int
 _cb_gcmark(void* user,
 	   const unsigned char* key, unsigned int sz,
-	   struct _value* v) {
+	   sluv_t* v) {
 	if (v->e)
-		_gcmark(NULL, v->e);
+		ylmp_gcmark(v->e);
 	return 1;
 }
 
 void
 ylslu_gcmark(slut_t* t) {
 	/* This is called by only 'GC in Mempool' */
-	yltrie_full_walk((yltrie_t*)t, NULL, (void*)&_cb_gcmark);
+	yltrie_full_walk(t->t, NULL, (void*)&_cb_gcmark);
+}
+
+static int
+_cb_relocate(void* user,
+	     const unsigned char* key, unsigned int sz,
+	     sluv_t* v) {
+	if (v->e)
+		v->e = (*(yle_t*(*)(yle_t*))user)(v->e);
+	return 1;
+}
+
+void
+ylslu_relocate(slut_t* t, yle_t* (*reloc)(yle_t*)) {
+	/* This is called by only 'compaction in Mempool' */
+	yltrie_full_walk(t->t, (void*)reloc, (void*)&_cb_relocate);
+}
+
+struct _walk_user {
+	void*   user;
+	int   (*cb)(void*, const char*, unsigned int, yle_t*);
+};
+
+static int
+_cb_walk(void* user,
+	 const unsigned char* key, unsigned int sz,
+	 sluv_t* v) {
+	struct _walk_user* u = user;
+	if (v->e)
+		return (*u->cb)(u->user, (const char*)key, sz, v->e);
+	return 1;
+}
+
+void
+ylslu_walk(slut_t* t, void* user,
+	   int (*cb)(void*, const char*, unsigned int, yle_t*)) {
+	struct _walk_user u;
+	u.user = user;
+	u.cb = cb;
+	yltrie_full_walk(t->t, &u, (void*)&_cb_walk);
 }
 
 int
 ylslu_auto_complete(slut_t* t, const char* start_with,
 		    char* buf, unsigned int bufsz) {
 	int    ret;
-	ret =yltrie_auto_complete((yltrie_t*)t,
+	ret =yltrie_auto_complete(t->t,
 				  (unsigned char*)start_with,
 				  (unsigned int)strlen(start_with),
 				  (unsigned char*)buf,
@@ -210,7 +334,7 @@ struct _candidates_sz {
 
 static int
 _cb_nr_candidates(void* user, const unsigned char* key,
-		  unsigned int sz,struct _value* v) {
+		  unsigned int sz,sluv_t* v) {
 	struct _candidates_sz* st = (struct _candidates_sz*)user;
 	st->cnt++;
 	if (st->maxlen < sz)
@@ -224,7 +348,7 @@ ylslu_nr_candidates(slut_t* t, const char* start_with,
 	struct _candidates_sz    st;
 	st.cnt = st.maxlen = 0;
 
-	if (0 > yltrie_walk((yltrie_t*)t,
+	if (0 > yltrie_walk(t->t,
 			    &st,
 			    (unsigned char*)start_with,
 			    (unsigned int)strlen(start_with),
@@ -245,7 +369,7 @@ struct _candidates {
 
 static int
 _cb_candidates(void* user, const unsigned char* key,
-	       unsigned int sz, struct _value* v) {
+	       unsigned int sz, sluv_t* v) {
 	struct _candidates* st = (struct _candidates*)user;
 	if (st->i >= st->ppbsz)
 		return 0; /* we should stop here! */
@@ -264,7 +388,7 @@ ylslu_candidates(slut_t* t, const char* start_with, char** ppbuf,
 	st.ppbsz = ppbsz;
 	st.i = 0;
 
-	if (0 > yltrie_walk((yltrie_t*)t,
+	if (0 > yltrie_walk(t->t,
 			    &st,
 			    (unsigned char*)start_with,
 			    (unsigned int)strlen(start_with),
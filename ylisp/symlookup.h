@@ -28,9 +28,44 @@
  */
 typedef struct _sSlut slut_t;
 
+/*
+ * Slot keeping value of symbol in the table.
+ * Slot is not changed while symbol is in the table. Re-assigning symbol
+ *   changes value in the slot in place. So, value can be read from the slot
+ *   directly while generation is not changed. (See 'ylg_slu_gen')
+ */
+typedef struct _sSluv {
+	/* this should matches symbol atom type - see 'yle_t.sty' for symbol */
+	short            ty;
+
+	/* description for this value */
+	char*            desc;
+
+	yle_t* volatile  e;
+} sluv_t;
+
+/*
+ * Generation of symbol tables whose values can be cached.
+ * This is increased whenever new symbol is inserted into or deleted from
+ *   those tables, or type of symbol is changed.
+ * It is always even number, and never 0.
+ * So, 0 and odd bit can be used by owners of generation tag.
+ *   (See '_cache_get' at sfunc.c)
+ */
+extern volatile unsigned int ylg_slu_gen;
 
+/**
+ * @cached : 1 if values in the table can be cached at call-site.
+ *           (See 'ylslu_get_slot')
+ */
 extern slut_t*
-ylslu_create(void);
+ylslu_create(int cached);
+
+/**
+ * @return: number of symbols in the table.
+ */
+extern unsigned int
+ylslu_nr(slut_t* t);
 
 extern void
 ylslu_destroy(slut_t*);
@@ -72,6 +107,14 @@ ylslu_get_description(slut_t* t, const char* sym);
 extern yle_t*
 ylslu_get(slut_t* t, short* outty, const char* sym);
 
+/**
+ * Same with 'ylslu_get'. But slot of the value is also returned.
+ * @slot [out]: slot of value. NULL if @sym is not in trie.
+ *              Value can be read from it while generation is not changed.
+ */
+extern yle_t*
+ylslu_get_slot(slut_t* t, short* outty, sluv_t** slot, const char* sym);
+
 /**
  * Mark memory blocks those can be reachable from Trie for GC.
  * @return: number of memblock that is marked as 'Reachable'
@@ -79,6 +122,23 @@ ylslu_get(slut_t* t, short* outty, const char* sym);
 extern void
 ylslu_gcmark(slut_t* t);
 
+/**
+ * Replace values in the table with the ones returned by @reloc.
+ * (Used when memory blocks are moved by compaction of memory pool.)
+ */
+extern void
+ylslu_relocate(slut_t* t, yle_t* (*reloc)(yle_t*));
+
+/**
+ * Walk all symbols in the table.
+ * @cb : return 1 for keep going, 0 for stop.
+ *       @sym is not 0-terminated. @symsz is length of it.
+ */
+extern void
+ylslu_walk(slut_t* t, void* user,
+	   int (*cb)(void* user, const char* sym, unsigned int symsz,
+		     yle_t* e));
+
 
 /**
  * get auto-completed-symbol
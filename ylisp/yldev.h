@@ -50,6 +50,8 @@
  ******************************************/
 
 #include <stdint.h>
+#include <math.h>
+#include <string.h>
 #include "ylisp.h"
 #include "yldef.h"
 
@@ -66,7 +68,7 @@
  *     "Difference in major version" means "incompatible"
  *     Version-Up SHOULD KEEP IT'S BACKWARD COMPATIBILITY!
  */
-#define YLDEV_VERSION 0x00010000
+#define YLDEV_VERSION 0x00010001
 
 #define yldev_ver_major(v) (((v)&0xffff0000)>>16)
 #define yldev_ver_minor(v) ((v)&0x0000ffff)
@@ -80,6 +82,21 @@ enum {
 	YLEGCMark        = 0x4000,  /**< Mark used only for GC */
 	YLEMark          = 0x2000,  /**< Bit for Mark.
 					 This is for several purpose! */
+	YLERemembered    = 0x1000,  /**< Used only for GC.
+					 Block is in remembered set */
+	YLEShortSym      = 0x0800,  /**< Symbol string is kept in block.
+					 (See 'ylaassign_ssym') */
+	YLEPinned        = 0x0400,  /**< Used only for compaction.
+					 Block cannot be moved */
+	YLEMoved         = 0x0200,  /**< Used only for compaction.
+					 car is new address of block */
+};
+
+/* --------------------------
+ * Sub types of binary atom
+ * --------------------------*/
+enum {
+	YLABin_lo        = 0x01,  /**< data is allocated by 'ylmp_lo_alloc' */
 };
 
 /*===================================
@@ -118,6 +135,18 @@ typedef struct _etcxt yletcxt_t;
  *
  *    clean :
  *        if NULL, yleclean does nothing except for warning log.
+ *
+ *    fin :
+ *        if 1, 'clean' of dead atom is run by finalizer thread.
+ *        Atom is already out of pool at that moment. So, 'clean' SHOULD
+ *          be thread-safe and SHOULD NOT access other blocks.
+ *        Omitted at initializer, means 0.
+ *
+ *    name / size :
+ *        used only by heap census. (See 'ylgc_census')
+ *        Atom whose 'name' is NULL, is counted as "custom".
+ *        If 'size' is NULL, atom has no payload out of pool.
+ *        Omitted at initializer, means NULL.
  */
 typedef struct {
 	/*
@@ -164,14 +193,43 @@ typedef struct {
 			       int(*)(void*/*user*/,
 				      struct yle*/*referred element*/));
 	void          (*clean)(struct yle*);
+	/*
+	 * 1: clean at finalizer thread / 0: clean at GC.
+	 * Use this for atom whose 'clean' is heavy.
+	 * (ex. destroying large data structure)
+	 */
+	int           fin;
+	/* type name */
+	const char*   name;
+	/*
+	 * @return : bytes of payload owned by atom - out of memory pool.
+	 * This is called while all threads are in safe state.
+	 */
+	unsigned long (*size)(const struct yle*);
 } ylatomif_t; /* atom inteface */
 
 /* nfunc : Native FUNCtion */
 typedef struct yle* (*ylnfunc_t)(yletcxt_t*, struct yle*, struct yle*);
 
+/*
+ * On LP64, there is padding between sub type and 'u'.
+ * Tag of call-site cache is kept there. Otherwise, it's kept in symbol.
+ * So, size of block isn't changed by it. (See 'ylasymtag')
+ */
+#if defined(__LP64__) || defined(_LP64)
+#       define YLE_HDR_TAG
+#endif
+
 typedef struct yle {
 	short    t;  /**< main type */
 	short    st; /**< sub type - atom specific. */
+#ifdef YLE_HDR_TAG
+	/*
+	 * Atom specific. This fills padding before 'u'.
+	 * Symbol uses it as tag of call-site cache. (See '_assoc' at sfunc.c)
+	 */
+	unsigned int x;
+#endif /* YLE_HDR_TAG */
 	union {
 		struct {
 			/*
@@ -187,12 +245,26 @@ typedef struct yle {
 			 */
 			union {
 				struct {
-					/**< depends on evaluated result of symbol */
 					union {
-						/* evaluated result - double */
-						double         d;
+						/* value of number (YLASym_num) */
+						struct yle*    c;
+						/*
+						 * call-site cache - slot of
+						 *   global symbol table
+						 */
+						void*          s;
 					} v;
-					char*          sym;
+#ifndef YLE_HDR_TAG
+					/* tag of call-site cache */
+					unsigned int   x;
+#endif /* YLE_HDR_TAG */
+					/* use 'ylasymstr()' to get string */
+					union {
+						/**< interned string */
+						char*  i;
+						/**< short string - YLEShortSym */
+						char   s[sizeof(char*)];
+					} str;
 				} sym; /**< for YLASymbol */
 
 				struct {
@@ -264,18 +336,54 @@ typedef struct yle {
 		}				\
 	}
 
-#define yleset_type(e, ty)      do { (e)->t = (ty); } while (0)
-#define yletype(e)              ((e)->t)
-#define ylestype(e)             ((e)->st)
-#define yleis_atom(e)           ((e)->t & YLEAtom)
+/*
+ * Immediate number
+ * ----------------
+ * Integral double is encoded into 'yle_t*' directly. (tagged pointer)
+ * Block is always aligned. So, LSB of block address is always 0.
+ *     ...xxxxx0 : address of block
+ *     ...xxxxx1 : integer (value << 1 | 1)
+ * Immediate number is atom of 'ylaif_dbl()' and it doesn't refer memory.
+ * So, there is nothing to allocate and GC treats it as always marked.
+ * (See 'ylacreate_dbl')
+ * Atom accessing macros below should be used instead of accessing 'yle_t'
+ *   directly.
+ */
+#define yleis_imm(e)            (!!((intptr_t)(e) & 1))
+#define ylimm_dbl(e)            ((double)((intptr_t)(e) >> 1))
+/* immediate number is in [-YLIMM_LIM, YLIMM_LIM) */
+#define YLIMM_LIM  ((double)((intptr_t)1 << (sizeof(intptr_t) * 8 - 2)))
+
+/*
+ * Bits for GC are kept even if type is changed.
+ * (Block that is already in use, may be re-assigned.)
+ */
+#define yleset_type(e, ty)						\
+	do {								\
+		(e)->t = ((e)->t & (YLEGCMark | YLERemembered)) | (ty); \
+	} while (0)
+#define yletype(e)              (yleis_imm(e)? YLEAtom: (e)->t)
+/* Immediate number has no sub type. Use 'yleset_stype' to set it */
+#define ylestype(e)             (yleis_imm(e)? 0: (e)->st)
+#define yleset_stype(e, sty)    do { (e)->st = (sty); } while (0)
+#define yleis_atom(e)           (yleis_imm(e) || ((e)->t & YLEAtom))
 
 /* macros for easy accessing */
 #define yleatom(e)              ((e)->u.a)
-#define ylaif(e)                ((e)->u.a.aif)
+#define ylaif(e)                (yleis_imm(e)? ylaif_dbl(): (e)->u.a.aif)
 #define ylasym(e)               ((e)->u.a.u.sym)
-#define ylasymd(e)              ((e)->u.a.u.sym.v.d)
+#define ylasymc(e)              ((e)->u.a.u.sym.v.c)
+#define ylasymslot(e)           ((e)->u.a.u.sym.v.s)
+#ifdef YLE_HDR_TAG
+#       define ylasymtag(e)    ((e)->x)
+#else /* YLE_HDR_TAG */
+#       define ylasymtag(e)    ((e)->u.a.u.sym.x)
+#endif /* YLE_HDR_TAG */
+#define ylasym_is_short(e)      (!!((e)->t & YLEShortSym))
+#define ylasymstr(e)            (ylasym_is_short(e)?			\
+				 ylasym(e).str.s: ylasym(e).str.i)
 #define ylanfunc(e)             ((e)->u.a.u.nfunc)
-#define yladbl(e)               ((e)->u.a.u.dbl)
+#define yladbl(e)               (yleis_imm(e)? ylimm_dbl(e): (e)->u.a.u.dbl)
 #define ylabin(e)               ((e)->u.a.u.bin)
 #define ylacd(e)                ((e)->u.a.u.cd)
 
@@ -295,7 +403,10 @@ typedef struct yle {
 
 #define yleset_gcmark(e)        ((e)->t |= YLEGCMark)
 #define yleclear_gcmark(e)      ((e)->t &= ~YLEGCMark)
-#define yleis_gcmark(e)         (!!((e)->t & YLEGCMark))
+/* immediate number is always marked - it's not in memory pool */
+#define yleis_gcmark(e)         (yleis_imm(e) || ((e)->t & YLEGCMark))
+
+#define yleis_remembered(e)     (!!((e)->t & YLERemembered))
 
 /*
  * Variable number of argument in macro,
@@ -321,6 +432,9 @@ typedef struct yle {
 #define ylmode()        (ylsysv()->mode)
 #define ylmpsz()        (ylsysv()->mpsz)
 #define ylgctp()        (ylsysv()->gctp)
+#define ylgcpause()     (ylsysv()->gcpause)
+#define ylgcthread()    (ylsysv()->gcthread)
+#define ylgcregion()    (ylsysv()->gcregion)
 /*
  * ! Predefined atoms !
  * To improve performance, we may use global variable instead of function.
@@ -512,12 +626,51 @@ ylunregister_nfunc(const char* sym);
 extern yle_t*
 ylmp_block(void);
 
+/*
+ * get yle_t block for pair.
+ * Pairs are kept close to each other in pool. (for locality)
+ */
+extern yle_t*
+ylmp_pblock(void);
+
 /*
  * add Base Block
  */
 extern void
 ylmp_add_bb(yle_t* e);
 
+/*
+ * Report memory owned / released by atom - out of pool.
+ * (ex. data of binary atom)
+ * It is counted at triggering GC. So, atom holding large memory should
+ *   report it. Otherwise, GC may not be triggered even if memory runs out.
+ * @sz : bytes
+ */
+extern void
+ylmp_ext_alloc(unsigned long sz);
+
+extern void
+ylmp_ext_free(unsigned long sz);
+
+/*
+ * Wait until finalizer thread cleans all atoms queued.
+ * (See 'fin' of 'ylatomif_t')
+ */
+extern void
+ylmp_fin_flush(void);
+
+/*
+ * Allocate memory for large payload.
+ * Large one is mapped from system directly - large object space.
+ * Memory should be freed by 'ylmp_lo_free'.
+ * Memory is not reported by these. (See 'ylmp_ext_alloc')
+ */
+extern void*
+ylmp_lo_alloc(unsigned long sz);
+
+extern void
+ylmp_lo_free(void* p);
+
 #define ylmp_add_bb1(e0)			\
 	do { ylmp_add_bb(e0); } while (0)
 
@@ -571,6 +724,10 @@ ylmp_add_bb(yle_t* e);
 
 /*
  * pop base block
+ * Base blocks are kept in stack of evaluation thread context.
+ * So, removing in reverse order of adding, is cheapest.
+ * 'ylmp_rm_bbN' removes blocks in reverse order of parameters.
+ * (Use same parameter order with 'ylmp_add_bbN')
  */
 extern void
 ylmp_rm_bb(yle_t* e);
@@ -578,52 +735,52 @@ ylmp_rm_bb(yle_t* e);
 #define ylmp_rm_bb1(e0)				\
 	do { ylmp_rm_bb(e0); } while (0)
 
-#define ylmp_rm_bb2(e0, e1)			\
-	do {					\
-		ylmp_rm_bb1(e0);		\
-		ylmp_rm_bb1(e1);		\
+#define ylmp_rm_bb2(e0, e1)		\
+	do {				\
+		ylmp_rm_bb1(e1);	\
+		ylmp_rm_bb1(e0);	\
 	} while (0)
 
-#define ylmp_rm_bb3(e0, e1, e2)			\
-	do {					\
-		ylmp_rm_bb1(e0);		\
-		ylmp_rm_bb2(e1, e2);		\
+#define ylmp_rm_bb3(e0, e1, e2)		\
+	do {				\
+		ylmp_rm_bb1(e2);	\
+		ylmp_rm_bb2(e0, e1);	\
 	} while (0)
 
 #define ylmp_rm_bb4(e0, e1, e2, e3)		\
-        do {					\
-		ylmp_rm_bb1(e0);		\
-		ylmp_rm_bb3(e1, e2, e3);	\
+	do {					\
+		ylmp_rm_bb1(e3);		\
+		ylmp_rm_bb3(e0, e1, e2);	\
 	} while (0)
 
 #define ylmp_rm_bb5(e0, e1, e2, e3, e4)		\
 	do {					\
-		ylmp_rm_bb1(e0);		\
-		ylmp_rm_bb4(e1, e2, e3, e4);	\
+		ylmp_rm_bb1(e4);		\
+		ylmp_rm_bb4(e0, e1, e2, e3);	\
 	} while (0)
 
 #define ylmp_rm_bb6(e0, e1, e2, e3, e4, e5)		\
 	do {						\
-		ylmp_rm_bb1(e0);			\
-		ylmp_rm_bb5(e1, e2, e3, e4, e5);	\
+		ylmp_rm_bb1(e5);			\
+		ylmp_rm_bb5(e0, e1, e2, e3, e4);	\
 	} while (0)
 
 #define ylmp_rm_bb7(e0, e1, e2, e3, e4, e5, e6)		\
 	do {						\
-		ylmp_rm_bb1(e0);			\
-		ylmp_rm_bb6(e1, e2, e3, e4, e5, e6);	\
+		ylmp_rm_bb1(e6);			\
+		ylmp_rm_bb6(e0, e1, e2, e3, e4, e5);	\
 	} while (0)
 
 #define ylmp_rm_bb8(e0, e1, e2, e3, e4, e5, e6, e7)		\
 	do {							\
-		ylmp_rm_bb1(e0);				\
-		ylmp_rm_bb7(e1, e2, e3, e4, e5, e6, e7);	\
+		ylmp_rm_bb1(e7);				\
+		ylmp_rm_bb7(e0, e1, e2, e3, e4, e5, e6);	\
 	} while (0)
 
 #define ylmp_rm_bb9(e0, e1, e2, e3, e4, e5, e6, e7, e8)		\
 	do {							\
-		ylmp_rm_bb1(e0);				\
-		ylmp_rm_bb8(e1, e2, e3, e4, e5, e6, e7, e8);	\
+		ylmp_rm_bb1(e8);				\
+		ylmp_rm_bb8(e0, e1, e2, e3, e4, e5, e6, e7);	\
 	} while (0)
 
 /*
@@ -632,6 +789,44 @@ ylmp_rm_bb(yle_t* e);
 extern void
 ylmp_clean_bb(void);
 
+/*
+ * Add block to remembered set of GC.
+ * Use 'ylmp_write_barrier' instead of calling this directly.
+ */
+extern void
+ylmp_remember(yle_t* e);
+
+/*
+ * Escape barrier for generational GC.
+ * Global symbol table is not scanned at minor GC.
+ * So, when 'e' is stored to global symbol table, this SHOULD BE called.
+ * ('ylgsym_insert' already does this.)
+ */
+extern void
+ylmp_escape(yle_t* e);
+
+/*
+ * End of region - evaluation of top-level expression is finished.
+ * Minor GC is run here in region mode. (See 'gcregion' of 'ylsys_t')
+ * Nothing should be referred from C stack of caller.
+ */
+extern void
+ylmp_region_end(yletcxt_t* cxt);
+
+/*
+ * Write barrier for generational GC.
+ * Old block(survived GC) is not scanned at minor GC.
+ * So, when reference of 'v' is stored to 'e', this SHOULD BE called.
+ * 'ylpsetcar/ylpsetcdr' already do this.
+ * But, atom that has references of other blocks (ex. array, map)
+ *   should call this whenever new reference is stored in it.
+ */
+static inline void
+ylmp_write_barrier(yle_t* e, yle_t* v) {
+	if (yleis_gcmark(e) && v && !yleis_gcmark(v) && !yleis_remembered(e))
+		ylmp_remember(e);
+}
+
 /* -------------------------------
  * Interface for multi-threaded evaluation
  * -------------------------------*/
@@ -700,24 +895,29 @@ ylechain_print(struct yldynb* dynb, const yle_t* e);
  *===================================*/
 /*
  * visit full node. return value is resolve til now.
+ * 'cdr' is visited by loop instead of recursion.
+ * So, long list doesn't consume stack.
+ * (Only depth of 'car' nesting consumes stack.)
  */
 #define _DEF_VISIT_FUNC(fTYPE, nAME, pREeXP, cOND, eXP)			\
 	fTYPE int							\
 	nAME(void* user, yle_t* e) {					\
-		pREeXP;							\
-		if (cOND) {						\
+		for (;;) {						\
+			pREeXP;						\
+			if (!(cOND))					\
+				break;					\
 			eXP;						\
 			if (yleis_atom(e)) {				\
 				if (ylaif(e)->visit)			\
 					ylaif(e)->visit(e, user, &nAME); \
-			} else {					\
-				ylassert((ylpcar(e) && ylpcdr(e))	\
-					 || (!ylpcar(e) && !ylpcdr(e))); \
-				if (ylpcar(e)) {			\
-					nAME(user, ylpcar(e));		\
-					nAME(user, ylpcdr(e));		\
-				}					\
+				break;					\
 			}						\
+			ylassert((ylpcar(e) && ylpcdr(e))		\
+				 || (!ylpcar(e) && !ylpcdr(e)));	\
+			if (!ylpcar(e))					\
+				break;					\
+			nAME(user, ylpcar(e));				\
+			e = ylpcdr(e);					\
 		}							\
 		return 0;						\
 	}
@@ -727,11 +927,13 @@ ylechain_print(struct yldynb* dynb, const yle_t* e);
  * --------------------------------*/
 static inline void
 ylpsetcar(yle_t* e, yle_t* exp) {
+	ylmp_write_barrier(e, exp);
 	ylpcar(e) = exp;
 }
 
 static inline void
 ylpsetcdr(yle_t* e, yle_t* exp) {
+	ylmp_write_barrier(e, exp);
 	ylpcdr(e) = exp;
 }
 
@@ -745,7 +947,7 @@ ylpassign(yle_t* e, yle_t* car, yle_t* cdr) {
 
 static inline yle_t*
 ylpcreate(yle_t* car, yle_t* cdr) {
-	yle_t* e = ylmp_block();
+	yle_t* e = ylmp_pblock();
 	ylpassign(e, car, cdr);
 	return e;
 }
@@ -800,14 +1002,99 @@ ylais_type_chain2(yle_t* e,
 /* --------------------------------
  * Element - Atom - Symbol
  * --------------------------------*/
+/*
+ * Symbol intern table. (See 'intern.c')
+ * String of symbol atom is interned one, except for short symbol.
+ * So, symbols having same name have same string pointer.
+ * Short symbol - shorter than size of pointer - is kept in block directly.
+ * (No allocation, no reference to intern table.)
+ */
+#define YLSSYM_MAX  (sizeof(char*) - 1) /* max length of short symbol */
+
+/**
+ * Get interned string. Reference count of it is increased.
+ * @return : NULL if fails (OOM)
+ */
+extern char*
+ylsym_intern(const char* s, unsigned int len);
+
+/**
+ * Same with 'ylsym_intern'. But @s is freed.
+ * @s : string allocated by 'ylmalloc'
+ * @return : NULL if fails (OOM) or @s is NULL
+ */
+extern char*
+ylsym_intern_own(char* s);
+
+/**
+ * Release reference of interned string.
+ */
+extern void
+ylsym_unref(const char* isym);
+
+/* length of interned string - cached at interning */
+extern unsigned int
+ylsym_len(const char* isym);
+
+/**
+ * @isym: [in] interned string. It's reference is passed to @e.
+ */
+static inline void
+ylaassign_isym(yle_t* e, char* isym) {
+	yleset_type(e, YLEAtom);
+	yleatom(e).aif = ylaif_sym();
+	ylasymtag(e) = 0; /* no cached value */
+	ylasym(e).str.i = isym;
+}
+
+/**
+ * @len: should not be larger than YLSSYM_MAX
+ */
+static inline void
+ylaassign_ssym(yle_t* e, const char* s, unsigned int len) {
+	yleset_type(e, YLEAtom | YLEShortSym);
+	yleatom(e).aif = ylaif_sym();
+	ylasymtag(e) = 0; /* no cached value */
+	/* unused bytes should be 0 for comparison (See '_aif_sym_eq') */
+	ylasym(e).str.i = NULL;
+	memcpy(ylasym(e).str.s, s, len);
+}
+
 /**
  * @sym: [in] responsibility for memory handling is passed to @se.
  */
 static inline void
 ylaassign_sym(yle_t* e, char* sym) {
-	yleset_type(e, YLEAtom);
-	ylaif(e) = ylaif_sym();
-	ylasym(e).sym = sym;
+	char*        isym;
+	unsigned int len = sym? (unsigned int)strlen(sym): 0;
+	if (sym && len <= YLSSYM_MAX) {
+		ylaassign_ssym(e, sym, len);
+		ylfree(sym);
+		return;
+	}
+	isym = ylsym_intern_own(sym);
+	if (sym && !isym)
+		ylinterp_fail(YLErr_out_of_memory,
+			      "Out Of Memory : [%d]!\n", len);
+	ylaassign_isym(e, isym);
+}
+
+/**
+ * @sym: [in] constant string. (ex. string literal)
+ */
+static inline void
+ylaassign_csym(yle_t* e, const char* sym) {
+	char*        isym;
+	unsigned int len = (unsigned int)strlen(sym);
+	if (len <= YLSSYM_MAX) {
+		ylaassign_ssym(e, sym, len);
+		return;
+	}
+	isym = ylsym_intern(sym, len);
+	if (!isym)
+		ylinterp_fail(YLErr_out_of_memory,
+			      "Out Of Memory : [%d]!\n", len);
+	ylaassign_isym(e, isym);
 }
 
 static inline yle_t*
@@ -823,7 +1110,7 @@ ylacreate_sym(char* sym) {
 static inline void
 ylaassign_nfunc(yle_t* e, ylnfunc_t f, const char* name) {
 	yleset_type(e, YLEAtom);
-	ylaif(e) = ylaif_nfunc();
+	yleatom(e).aif = ylaif_nfunc();
 	ylanfunc(e).f = f;
 	ylanfunc(e).name = name;
 }
@@ -831,7 +1118,7 @@ ylaassign_nfunc(yle_t* e, ylnfunc_t f, const char* name) {
 static inline void
 ylaassign_sfunc(yle_t* e, ylnfunc_t f, const char* name) {
 	yleset_type(e, YLEAtom);
-	ylaif(e) = ylaif_sfunc();
+	yleatom(e).aif = ylaif_sfunc();
 	ylanfunc(e).f = f;
 	ylanfunc(e).name = name;
 }
@@ -857,13 +1144,22 @@ ylacreate_sfunc(ylnfunc_t f, const char* name) {
 static inline void
 ylaassign_dbl(yle_t* e, double d) {
 	yleset_type(e, YLEAtom);
-	ylaif(e) = ylaif_dbl();
-	yladbl(e) = d;
+	yleatom(e).aif = ylaif_dbl();
+	yleatom(e).u.dbl = d;
 }
 
+/*
+ * Integral value is created as immediate number. (No allocation)
+ * (-0 is not integral here. Sign of it should be kept.)
+ */
 static inline yle_t*
 ylacreate_dbl(double d) {
-	yle_t* e = ylmp_block();
+	yle_t* e;
+	if (d >= -YLIMM_LIM && d < YLIMM_LIM
+	    && d == (double)(intptr_t)d
+	    && (d != 0 || !signbit(d)))
+		return (yle_t*)(((uintptr_t)(intptr_t)d << 1) | 1);
+	e = ylmp_block();
 	ylaassign_dbl(e, d);
 	return e;
 }
@@ -874,9 +1170,11 @@ ylacreate_dbl(double d) {
 static inline void
 ylaassign_bin(yle_t* e, unsigned char* data, unsigned int len) {
 	yleset_type(e, YLEAtom);
-	ylaif(e) = ylaif_bin();
+	yleset_stype(e, 0);
+	yleatom(e).aif = ylaif_bin();
 	ylabin(e).d = data;
 	ylabin(e).sz = len;
+	ylmp_ext_alloc(len);
 }
 
 static inline yle_t*
@@ -886,13 +1184,24 @@ ylacreate_bin(unsigned char* data, unsigned int len) {
 	return e;
 }
 
+/**
+ * @data: [in] allocated by 'ylmp_lo_alloc'.
+ */
+static inline yle_t*
+ylacreate_lobin(unsigned char* data, unsigned int len) {
+	yle_t* e = ylmp_block();
+	ylaassign_bin(e, data, len);
+	yleset_stype(e, YLABin_lo);
+	return e;
+}
+
 /* --------------------------------
  * Element - Atom - Custom
  * --------------------------------*/
 static inline void
 ylaassign_cust(yle_t* e, const ylatomif_t* aif, void* data) {
 	yleset_type(e, YLEAtom);
-	ylaif(e) = aif;
+	yleatom(e).aif = aif;
 	ylacd(e) = data;
 }
 
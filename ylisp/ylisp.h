@@ -147,14 +147,47 @@ typedef struct {
 	/* YLMode_batch/repl */
 	int	     mode;
 
-	/* interpreter memory pool size*/
+	/*
+	 * interpreter memory pool size - number of blocks.
+	 * Memory pool grows on demand, and shrinks when it is mostly empty.
+	 * So, this is not hard limit. This is base size of GC trigger.
+	 * (See 'gctp')
+	 */
 	unsigned int mpsz;
 
 	/*
 	 * GC Trigger point. Percent.
-	 * '80' means "GC triggered when memory pool is used over 80%
+	 * '80' means "GC triggered when blocks allocated since last GC are
+	 *   over 80% of live data. ('mpsz' is used instead of size of live
+	 *   data, if live data is smaller than 'mpsz')"
 	 */
 	int	     gctp; /* Garbage Collection Trigger Pointer */
+
+	/*
+	 * GC pause budget. micro-second.
+	 * If this is not 0, GC is done incrementally. That is, GC is done in
+	 *   slices and one slice is tried to be finished in this time.
+	 * '0' means "Do whole GC at once (no incremental GC)"
+	 */
+	unsigned int gcpause;
+
+	/*
+	 * Number of threads used for GC - marking and sweeping.
+	 * Thread running GC is also counted.
+	 * '0' means "Number of online processors"
+	 */
+	unsigned int gcthread;
+
+	/*
+	 * Region mode. (0 or 1)
+	 * If this is 1, blocks allocated while top-level expression is
+	 *   evaluated, are reclaimed in bulk - by minor GC - when evaluation
+	 *   of the expression is finished. Only blocks escaped to symbol
+	 *   table survive. So, temporaries are not promoted to old by GC
+	 *   in the middle of evaluation, and full GC is rarely needed.
+	 * '0' means "Blocks are reclaimed only when GC is triggered"
+	 */
+	int	     gcregion;
 } ylsys_t; /* system parameter	*/
 
 /**
@@ -169,6 +202,9 @@ typedef struct {
  * mode	   : YLMode_batch
  * mpsz	   : 1MByte
  * gctp	   : 80
+ * gcpause : 0 (no incremental GC)
+ * gcthread: 0 (number of online processors)
+ * gcregion: 0 (no region mode)
  *
  * @return : < 0 for error.
  */
@@ -253,4 +289,119 @@ ylsym_candidates(const char* start_with,
 		 /* size of pbuf - regarding 'ppbuf[0][x]' */
 		 unsigned int pbsz);
 
+/**
+ * Get GC pause time at given percentile.
+ * Pause time is recorded to histogram whose bucket resolution is about
+ *   12%. So, returned value is upper bound of bucket.
+ * @pct    : percentile (0 - 100). ex. 99 means 99th percentile.
+ * @return : micro-second. 0 if there is no GC pause recorded yet.
+ */
+extern unsigned long long
+ylgc_pause_percentile(unsigned int pct);
+
+/**
+ * GC and memory pool statistics.
+ * Counters are accumulated since 'ylinit'.
+ * Unit of memory is 'block'.
+ */
+typedef struct {
+	unsigned long long nr_gc;      /**< GC cycles finished */
+	unsigned long long nr_full_gc; /**< full GC cycles finished */
+	unsigned long long collected;  /**< blocks collected */
+	unsigned long long alloc;      /**< blocks allocated */
+	/* average number of blocks allocated per second */
+	unsigned long long alloc_rate;
+	unsigned long long nr_pause;   /**< GC pauses (slices) */
+	unsigned long long pause_total;/**< sum of pause time. usec */
+	unsigned long long pause_max;  /**< usec */
+	/* pause time at 50/90/99th percentile. usec */
+	unsigned long long pause_p50;
+	unsigned long long pause_p90;
+	unsigned long long pause_p99;
+	unsigned int       used;       /**< blocks in use */
+	unsigned int       peak;       /**< peak of 'used' */
+	unsigned int       live;       /**< blocks survived last GC */
+	unsigned int       poolsz;     /**< blocks in pool */
+	unsigned int       nr_grow;    /**< pool growth */
+	unsigned int       nr_shrink;  /**< pool shrink */
+	/* deepest base block (GC root) stack seen by GC */
+	unsigned int       bbs_max;
+	/* bytes owned by atoms out of pool. (See 'ylmp_ext_alloc') */
+	unsigned long      ext;
+	unsigned long      ext_peak;   /**< peak of 'ext' */
+	unsigned long      lo;         /**< bytes in large object space */
+	unsigned int       nr_compact; /**< compactions done */
+	unsigned long long moved;      /**< pairs moved by compaction */
+} ylgcstat_t;
+
+/**
+ * Get snapshot of GC statistics.
+ */
+extern void
+ylgc_stat(ylgcstat_t* st);
+
+/**
+ * Request compaction of memory pool.
+ * Live pairs are packed into fewer chunks after full GC.
+ * It's done when no thread is evaluating expression - at the end of
+ *   top-level expression. So, this doesn't wait for it.
+ */
+extern void
+ylgc_compact(void);
+
+/*
+ * Heap census - what is live in memory pool.
+ */
+#define YLCENSUS_TYPE_MAX  16  /**< types distinguished by census */
+#define YLCENSUS_TOP_MAX   16  /**< symbols reported by census */
+#define YLCENSUS_NAME_MAX  32  /**< type name is truncated to this */
+#define YLCENSUS_SYM_MAX   64  /**< symbol name is truncated to this */
+
+typedef struct {
+	/*
+	 * Blocks by type. "pair" for pair. Otherwise 'name' of atom
+	 *   interface. (See 'ylatomif_t')
+	 * Atoms of unnamed types, are counted as "custom".
+	 */
+	struct {
+		char          name[YLCENSUS_NAME_MAX];
+		unsigned int  cnt;    /**< number of blocks */
+		unsigned long bytes;  /**< payload bytes out of pool */
+	} ty[YLCENSUS_TYPE_MAX];
+	unsigned int nty;
+
+	/*
+	 * Symbols retaining the most. Sorted by 'bytes'.
+	 * Retained size of symbol is size of blocks - and their payloads -
+	 *   reachable from its value. So, structure shared by several
+	 *   symbols is counted at each of them.
+	 */
+	struct {
+		char          sym[YLCENSUS_SYM_MAX];
+		int           local;  /**< 1 if per-thread symbol */
+		unsigned int  cnt;    /**< number of blocks */
+		unsigned long bytes;  /**< block and payload bytes */
+	} top[YLCENSUS_TOP_MAX];
+	unsigned int ntop;
+} ylcensus_t;
+
+/**
+ * Take heap census after full GC.
+ * This SHOULD be called while interpreter is not evaluating.
+ *   (ex. between 'ylinterpret' calls.)
+ * Use 'heap-census' in script to take it while evaluating.
+ */
+extern void
+ylgc_census(ylcensus_t* c);
+
+/**
+ * Write census to file. One line per record. So, two snapshots can be
+ *   compared by line-based tools - ex. diff.
+ *    type <name> <cnt> <bytes>
+ *    sym <g|l> <name> <cnt> <bytes>
+ * @return : <0 if fails.
+ */
+extern int
+ylgc_census_dump(const ylcensus_t* c, const char* fpath);
+
 #endif /* ___YLISp_h___ */
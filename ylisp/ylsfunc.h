@@ -69,6 +69,26 @@ yleq(const yle_t* e1, const yle_t* e2);
 extern yle_t*
 yleval(yletcxt_t* cxt, yle_t* e, yle_t* a);
 
+/**
+ * Evaluate 'e' in tail position - proper tail call.
+ * 'e' is not evaluated here. It is evaluated by the nearest 'yleval'
+ *   in place of the expression being evaluated - without growing stack.
+ * So, returned value SHOULD BE returned directly to the caller.
+ *   And this SHOULD BE used only in functions called by 'yleval'.
+ *   (ex. return yleval_tail(cxt, ylcar(e), a); at 'YLDEFNF')
+ * 'e' and 'a' are protected from GC until evaluation.
+ */
+extern yle_t*
+yleval_tail(yletcxt_t* cxt, yle_t* e, yle_t* a);
+
+/**
+ * Pair is changed in place. (ex. 'setcar')
+ * Macro expansions cached may be the one changed. So, they are not used
+ *   anymore.
+ */
+extern void
+ylmcache_invalidate(void);
+
 /*=================================
  * Elementary S-functions - START
  *=================================*/
@@ -359,6 +359,9 @@ main(int argc, char* argv[]) {
 		sys.mode      = YLMode_repl;
 		sys.mpsz      = 1024*1024; /* memory pool size */
 		sys.gctp      = 80;
+		sys.gcpause   = 0;
+		sys.gcthread  = 0;
+		sys.gcregion  = 0;
 
 		if (YLOk != ylinit(&sys)) {
 			printf("Error: Fail to initialize ylisp\n");
@@ -70,6 +70,9 @@ main(int argc, char* argv[]) {
 	sys.mode    = YLMode_repl;
 	sys.mpsz    = 1024*1024;
 	sys.gctp    = 80;
+	sys.gcpause = 0;
+	sys.gcthread = 0;
+	sys.gcregion = 1;
 
 	if (YLOk != ylinit(&sys)) {
 		printf("Fail to initialize ylisp\n");